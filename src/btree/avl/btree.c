@@ -0,0 +1,290 @@
+/*
+ * Binárny vyhľadávací strom — vyvážená varianta (AVL strom)
+ *
+ * Strom má rovnaké rozhranie ako rekurzívna a iteratívna varianta, ale po
+ * každom vložení a odstránení uzlu sa na ceste ku koreňu obnoví podmienka
+ * vyváženosti: výšky podstromov každého uzlu sa líšia najviac o jedna. Výška
+ * stromu je preto vždy O(log n), aj keď sú kľúče vkladané zoradené.
+ */
+
+#include "../btree.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Node of the AVL tree, allocated by bst_insert of this variant only (the
+// functions get the pointer to its first member)
+typedef struct avl_node {
+    bst_node_t node;      // node of btree.h
+    unsigned char height; // height of the subtree
+} avl_node_t;
+
+/*
+ * Returns height of the subtree (0 for an empty one).
+ */
+static inline int avl_height(bst_node_t *tree) {
+    return tree != NULL ? ((avl_node_t *) tree)->height : 0;
+}
+
+/*
+ * Recomputes height of the node from the heights of its subtrees.
+ */
+static inline void avl_update(bst_node_t *tree) {
+    int left = avl_height(tree->left);
+    int right = avl_height(tree->right);
+    ((avl_node_t *) tree)->height = (unsigned char) ((left > right ? left : right) + 1);
+}
+
+/*
+ * Rotation to the right — left child of the node becomes root of the subtree.
+ */
+static void avl_rotate_right(bst_node_t **tree) {
+    bst_node_t *root = (*tree)->left;
+    (*tree)->left = root->right;
+    root->right = *tree;
+
+    avl_update(*tree);
+    avl_update(root);
+    *tree = root;
+}
+
+/*
+ * Rotation to the left — right child of the node becomes root of the subtree.
+ */
+static void avl_rotate_left(bst_node_t **tree) {
+    bst_node_t *root = (*tree)->right;
+    (*tree)->right = root->left;
+    root->left = *tree;
+
+    avl_update(*tree);
+    avl_update(root);
+    *tree = root;
+}
+
+/*
+ * Restores balance of the subtree whose children are balanced and their
+ * heights differ at most by two (it holds after one insertion or deletion).
+ */
+static void avl_rebalance(bst_node_t **tree) {
+    bst_node_t *node = *tree;
+    int balance = avl_height(node->right) - avl_height(node->left);
+
+    if (balance < -1) {
+        // Left subtree is too high, its inner grandchild needs double rotation
+        if (avl_height(node->left->left) < avl_height(node->left->right)) {
+            avl_rotate_left(&node->left);
+        }
+        avl_rotate_right(tree);
+    } else if (balance > 1) {
+        if (avl_height(node->right->right) < avl_height(node->right->left)) {
+            avl_rotate_right(&node->right);
+        }
+        avl_rotate_left(tree);
+    } else {
+        avl_update(node);
+    }
+}
+
+/*
+ * Inicializácia stromu.
+ *
+ * Užívateľ musí zaistiť, že incializácia sa nebude opakovane volať nad
+ * inicializovaným stromom. V opačnom prípade môže dôjsť k úniku pamäte (memory
+ * leak). Keďže neinicializovaný ukazovateľ má nedefinovanú hodnotu, nie je
+ * možné toto detegovať vo funkcii.
+ */
+void bst_init(bst_node_t **tree) {
+    *tree = NULL;
+}
+
+/*
+ * Nájdenie uzlu v strome.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true a do premennej value zapíše
+ * hodnotu daného uzlu. V opačnom prípade funckia vráti hodnotu false a premenná
+ * value ostáva nezmenená.
+ */
+bool bst_search(bst_node_t *tree, char key, int *value) {
+    // Height of the tree is logarithmic, so the loop is short
+    while (tree != NULL) {
+        if (key < tree->key) {
+            tree = tree->left;
+        } else if (key > tree->key) {
+            tree = tree->right;
+        } else {
+            *value = tree->value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Vloženie uzlu do stromu.
+ *
+ * Pokiaľ uzol so zadaným kľúčom v strome už existuje, nahraďte jeho hodnotu.
+ * Inak vložte nový listový uzol a na ceste ku koreňu obnovte vyváženosť.
+ *
+ * Výsledný strom musí spĺňať podmienku vyhľadávacieho stromu — ľavý podstrom
+ * uzlu obsahuje iba menšie kľúče, pravý väčšie.
+ */
+void bst_insert(bst_node_t **tree, char key, int value) {
+    if (*tree == NULL) {
+        // Empty tree --> create new leaf
+        avl_node_t *leaf;
+        if ((leaf = malloc(sizeof(avl_node_t))) == NULL) {
+            return;
+        }
+
+        leaf->height = 1;
+        *tree = &leaf->node;
+        (*tree)->key = key;
+        (*tree)->value = value;
+        (*tree)->left = NULL;
+        (*tree)->right = NULL;
+
+        return;
+    }
+
+    if (key < (*tree)->key) {
+        bst_insert(&(*tree)->left, key, value);
+    } else if (key > (*tree)->key) {
+        bst_insert(&(*tree)->right, key, value);
+    } else {
+        // Keys is already in the tree --> only edit value, shape isn't changed
+        (*tree)->value = value;
+
+        return;
+    }
+
+    avl_rebalance(tree);
+}
+
+/*
+ * Pomocná funkcia ktorá nahradí uzol najpravejším potomkom.
+ *
+ * Kľúč a hodnota uzlu target budú nahradené kľúčom a hodnotou najpravejšieho
+ * uzlu podstromu tree. Najpravejší potomok bude odstránený. Funkcia korektne
+ * uvoľní všetky alokované zdroje odstráneného uzlu a obnoví vyváženosť
+ * podstromu tree.
+ *
+ * Funkcia predpokladá že hodnota tree nie je NULL.
+ */
+void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
+    if ((*tree)->right == NULL) {
+        // Rightmost node
+        target->key = (*tree)->key;
+        target->value = (*tree)->value;
+
+        bst_node_t *left_subtree = (*tree)->left;
+        free(*tree);
+        *tree = left_subtree;
+        return;
+    }
+
+    bst_replace_by_rightmost(target, &((*tree)->right));
+    avl_rebalance(tree);
+}
+
+/*
+ * Odstránenie uzlu v strome.
+ *
+ * Pokiaľ uzol so zadaným kľúčom neexistuje, funkcia nič nerobí.
+ * Pokiaľ má odstránený uzol jeden podstrom, zdedí ho otec odstráneného uzla.
+ * Pokiaľ má odstránený uzol oba podstromy, je nahradený najpravejším uzlom
+ * ľavého podstromu. Na ceste ku koreňu sa obnoví vyváženosť.
+ * Funkcia korektne uvoľní všetky alokované zdroje odstráneného uzlu.
+ */
+void bst_delete(bst_node_t **tree, char key) {
+    if (*tree == NULL) {
+        // Empty tree --> key can't be contained inside it
+        return;
+    }
+
+    if (key < (*tree)->key) {
+        bst_delete(&(*tree)->left, key);
+    } else if (key > (*tree)->key) {
+        bst_delete(&(*tree)->right, key);
+    } else if ((*tree)->left != NULL && (*tree)->right != NULL) {
+        // The node has BOTH children
+        bst_replace_by_rightmost(*tree, &((*tree)->left));
+    } else {
+        // The node has at most one child, it takes place of the node
+        bst_node_t *node = *tree;
+        *tree = node->left != NULL ? node->left : node->right;
+        free(node);
+
+        // Only child of a balanced node is a leaf, it needs no rebalancing
+        return;
+    }
+
+    avl_rebalance(tree);
+}
+
+/*
+ * Zrušenie celého stromu.
+ *
+ * Po zrušení sa celý strom bude nachádzať v rovnakom stave ako po
+ * inicializácii. Funkcia korektne uvoľní všetky alokované zdroje rušených
+ * uzlov.
+ */
+void bst_dispose(bst_node_t **tree) {
+    if (*tree == NULL) {
+        // Empty tree --> there nothing to delete
+        return;
+    }
+
+    // Recursion depth is bounded by the height of the tree
+    bst_dispose(&((*tree)->left));
+    bst_dispose(&((*tree)->right));
+    free(*tree);
+    (*tree) = NULL;
+}
+
+/*
+ * Preorder prechod stromom.
+ *
+ * Pre aktuálne spracovávaný uzol nad ním zavolajte funkciu bst_print_node.
+ */
+void bst_preorder(bst_node_t *tree) {
+    if (tree == NULL) {
+        // Empty tree -> we're done here
+        return;
+    }
+
+    bst_print_node(tree);
+    bst_preorder(tree->left);
+    bst_preorder(tree->right);
+}
+
+/*
+ * Inorder prechod stromom.
+ *
+ * Pre aktuálne spracovávaný uzol nad ním zavolajte funkciu bst_print_node.
+ */
+void bst_inorder(bst_node_t *tree) {
+    if (tree == NULL) {
+        // Empty tree -> we're done here
+        return;
+    }
+
+    bst_inorder(tree->left);
+    bst_print_node(tree);
+    bst_inorder(tree->right);
+}
+
+/*
+ * Postorder prechod stromom.
+ *
+ * Pre aktuálne spracovávaný uzol nad ním zavolajte funkciu bst_print_node.
+ */
+void bst_postorder(bst_node_t *tree) {
+    if (tree == NULL) {
+        // Empty tree -> we're done here
+        return;
+    }
+
+    bst_postorder(tree->left);
+    bst_postorder(tree->right);
+    bst_print_node(tree);
+}
@@ -0,0 +1,46 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "bench_util.h"
+#include <limits.h>
+#include <time.h>
+
+uint64_t bench_random(uint64_t *state) {
+  // splitmix64
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+double bench_now() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/*
+ * Returns how many times a tree of count keys is built to measure at least
+ * the given number of insertions (smaller trees are built repeatedly to get
+ * measurable times).
+ */
+size_t bench_rounds(size_t count, size_t inserts) {
+  return count < inserts ? inserts / count : 1;
+}
+
+/*
+ * Fills the keys with a random permutation of count char keys spread evenly
+ * over the whole range of char (count divides 256).
+ */
+void bench_char_keys(char *keys, int count, uint64_t *state) {
+  for (int i = 0; i < count; i++) {
+    keys[i] = (char)(CHAR_MIN + i * (256 / count));
+  }
+  for (int i = count; i > 1; i--) {
+    int j = (int)(bench_random(state) % (uint64_t)i);
+    char tmp = keys[i - 1];
+    keys[i - 1] = keys[j];
+    keys[j] = tmp;
+  }
+}
@@ -0,0 +1,16 @@
+/*
+ * Header file for the helpers shared by the tree benchmarks.
+ */
+
+#ifndef IAL_BTREE_BENCH_UTIL_H
+#define IAL_BTREE_BENCH_UTIL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+uint64_t bench_random(uint64_t *state);
+double bench_now();
+size_t bench_rounds(size_t count, size_t inserts);
+void bench_char_keys(char *keys, int count, uint64_t *state);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Benchmark of the B+-tree against the binary search tree.
+ *
+ * bst_node_t holds char keys (at most 256 of them), so the binary tree is
+ * reimplemented here with int keys and the same insertion and search loops as
+ * iter/btree.c. Keys are inserted in random order, so the binary tree stays
+ * reasonably balanced and the difference comes from the layout of the nodes.
+ *
+ * Usage: bench-bplus [max_keys] (10^7 by default, 10^8 needs about 4 GB)
+ */
+
+#include "../bplus/bptree.h"
+#include "bench_util.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SEARCHES 1000000
+
+// Number of measured insertions for every tree size
+#define MIN_INSERTS 1000000
+
+// Node of the binary tree with int key (same layout as bst_node_t otherwise)
+typedef struct node {
+  int key;
+  int value;
+  struct node *left;
+  struct node *right;
+} node_t;
+
+volatile int sink;
+
+void bst_int_insert(node_t **tree, int key, int value) {
+  node_t *where = NULL;
+  node_t *current = *tree;
+  while (current != NULL) {
+    where = current;
+    if (key < current->key) {
+      current = current->left;
+    } else if (key > current->key) {
+      current = current->right;
+    } else {
+      current->value = value;
+      return;
+    }
+  }
+
+  node_t *node = malloc(sizeof(node_t));
+  if (node == NULL) {
+    return;
+  }
+  node->key = key;
+  node->value = value;
+  node->left = NULL;
+  node->right = NULL;
+
+  if (where == NULL) {
+    *tree = node;
+  } else if (key < where->key) {
+    where->left = node;
+  } else {
+    where->right = node;
+  }
+}
+
+bool bst_int_search(node_t *tree, int key, int *value) {
+  while (tree != NULL) {
+    if (tree->key == key) {
+      *value = tree->value;
+      return true;
+    }
+    tree = key < tree->key ? tree->left : tree->right;
+  }
+
+  return false;
+}
+
+void bst_int_dispose(node_t *tree) {
+  if (tree != NULL) {
+    bst_int_dispose(tree->left);
+    bst_int_dispose(tree->right);
+    free(tree);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const size_t sizes[] = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+  size_t max_keys = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+  printf("Random insertion and search (nanoseconds per operation)\n\n");
+  printf("%10s %6s %10s %10s %10s\n", "keys", "tree", "insert", "search",
+         "scan");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    if (count > max_keys) {
+      break;
+    }
+
+    // Random permutation of the keys
+    int *keys = malloc(count * sizeof(int));
+    int *lookups = malloc(SEARCHES * sizeof(int));
+    if (keys == NULL || lookups == NULL) {
+      return 1;
+    }
+    uint64_t state = 1;
+    for (size_t i = 0; i < count; i++) {
+      keys[i] = (int)i;
+    }
+    for (size_t i = count; i > 1; i--) {
+      size_t j = (size_t)(bench_random(&state) % i);
+      int tmp = keys[i - 1];
+      keys[i - 1] = keys[j];
+      keys[j] = tmp;
+    }
+    for (size_t i = 0; i < SEARCHES; i++) {
+      lookups[i] = (int)(bench_random(&state) % count);
+    }
+    size_t rounds = bench_rounds(count, MIN_INSERTS);
+
+    // Binary tree
+    node_t *bst = NULL;
+    double insert_time = 0;
+    for (size_t r = 0; r < rounds; r++) {
+      bst_int_dispose(bst);
+      bst = NULL;
+      double start = bench_now();
+      for (size_t i = 0; i < count; i++) {
+        bst_int_insert(&bst, keys[i], (int)i);
+      }
+      insert_time += bench_now() - start;
+    }
+
+    int sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < SEARCHES; i++) {
+      int value;
+      if (bst_int_search(bst, lookups[i], &value)) {
+        sum += value;
+      }
+    }
+    double search_time = bench_now() - start;
+    bst_int_dispose(bst);
+
+    printf("%10zu %6s %10.1f %10.1f %10s\n", count, "bst",
+           insert_time * 1e9 / ((double)rounds * count),
+           search_time * 1e9 / SEARCHES, "-");
+
+    // B+-tree
+    bpt_tree_t tree;
+    bpt_init(&tree);
+    insert_time = 0;
+    for (size_t r = 0; r < rounds; r++) {
+      bpt_dispose(&tree);
+      start = bench_now();
+      for (size_t i = 0; i < count; i++) {
+        bpt_insert(&tree, keys[i], (int)i);
+      }
+      insert_time += bench_now() - start;
+    }
+
+    start = bench_now();
+    for (size_t i = 0; i < SEARCHES; i++) {
+      int value;
+      if (bpt_search(&tree, lookups[i], &value)) {
+        sum += value;
+      }
+    }
+    search_time = bench_now() - start;
+
+    bpt_cursor_t cursor;
+    int key, value;
+    bpt_cursor_init(&tree, &cursor, 0);
+    start = bench_now();
+    while (bpt_cursor_next(&cursor, &key, &value)) {
+      sum += value;
+    }
+    double scan_time = bench_now() - start;
+    sink = sum;
+    bpt_dispose(&tree);
+
+    printf("%10zu %6s %10.1f %10.1f %10.1f\n", count, "b+",
+           insert_time * 1e9 / ((double)rounds * count),
+           search_time * 1e9 / SEARCHES, scan_time * 1e9 / count);
+
+    free(keys);
+    free(lookups);
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Benchmark of the allocation of the tree nodes.
+ *
+ * Trees are built in random order and disposed repeatedly, and a tree with
+ * all the 256 char keys is churned by deleting and reinserting random keys.
+ * The same file is linked with the rec and iter variants, once with the nodes
+ * allocated from pool.c and once with -DBST_NO_POOL (malloc and free of every
+ * node).
+ */
+
+#include "../btree.h"
+#include "bench_util.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// Number of measured insertions for every tree size
+#define INSERTS 2000000
+#define CHURNS 20000000
+
+volatile int sink;
+
+int main() {
+  const int sizes[] = {16, 64, 256};
+  uint64_t state = 1;
+
+#ifdef BST_NO_POOL
+  printf("Nodes allocated by malloc (nanoseconds per operation)\n\n");
+#else
+  printf("Nodes allocated from pools (nanoseconds per operation)\n\n");
+#endif
+  printf("%6s %10s %10s %10s\n", "keys", "insert", "dispose", "churn");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    int count = sizes[s];
+    int rounds = (int)bench_rounds((size_t)count, INSERTS);
+    bst_node_t *tree;
+
+    // Random permutation of the keys
+    char keys[256];
+    bench_char_keys(keys, count, &state);
+
+    double insert_time = 0;
+    double dispose_time = 0;
+    for (int r = 0; r < rounds; r++) {
+      bst_init(&tree);
+      double start = bench_now();
+      for (int i = 0; i < count; i++) {
+        bst_insert(&tree, keys[i], i);
+      }
+      double middle = bench_now();
+      bst_dispose(&tree);
+      insert_time += middle - start;
+      dispose_time += bench_now() - middle;
+    }
+
+    // Every deleted key is inserted back, so the size of the tree is kept
+    bst_init(&tree);
+    for (int i = 0; i < count; i++) {
+      bst_insert(&tree, keys[i], i);
+    }
+
+    double start = bench_now();
+    for (int i = 0; i < CHURNS; i++) {
+      char key = keys[bench_random(&state) % (uint64_t)count];
+      bst_delete(&tree, key);
+      bst_insert(&tree, key, i);
+    }
+    double churn_time = bench_now() - start;
+
+    int value = 0;
+    bst_search(tree, keys[0], &value);
+    sink = value;
+    bst_dispose(&tree);
+
+    printf("%6d %10.1f %10.1f %10.1f\n", count,
+           insert_time * 1e9 / ((double)rounds * count),
+           dispose_time * 1e9 / ((double)rounds * count),
+           churn_time * 1e9 / CHURNS);
+  }
+
+  return 0;
+}
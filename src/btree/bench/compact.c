@@ -0,0 +1,112 @@
+/*
+ * Benchmark of the compact tree against the tree of bst_node_t.
+ *
+ * Keys are of type char, so a single tree (at most 256 nodes) fits into the
+ * cache either way. Many trees with about 2^20 nodes in total are built
+ * instead and random keys are searched in random trees, so the node size
+ * matters. The tree of bst_node_t is the iter variant (with the nodes from
+ * pool.c).
+ */
+
+#include "../btree.h"
+#include "../compact/compact.h"
+#include "bench_util.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TOTAL_NODES (1 << 20)
+#define SEARCHES 10000000
+
+volatile int sink;
+
+int main() {
+  const int sizes[] = {16, 64, 256};
+  uint64_t state = 1;
+
+  printf("Forests of %d nodes (nanoseconds per operation)\n", TOTAL_NODES);
+  printf("Node size: bst_node_t %zu B, bstc_node_t %zu B\n\n",
+         sizeof(bst_node_t), sizeof(bstc_node_t));
+  printf("%6s %8s %8s %10s %10s\n", "keys", "trees", "tree", "insert",
+         "search");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    int count = sizes[s];
+    int trees = TOTAL_NODES / count;
+
+    // Random permutation of the keys and random lookups
+    char keys[256];
+    bench_char_keys(keys, count, &state);
+    int *lookups = malloc(SEARCHES * sizeof(int));
+    bst_node_t **forest = malloc((size_t)trees * sizeof(bst_node_t *));
+    bstc_tree_t *compact_forest = malloc((size_t)trees * sizeof(bstc_tree_t));
+    if (lookups == NULL || forest == NULL || compact_forest == NULL) {
+      return 1;
+    }
+    for (int i = 0; i < SEARCHES; i++) {
+      lookups[i] = (int)(bench_random(&state) % (uint64_t)TOTAL_NODES);
+    }
+
+    // Trees of bst_node_t
+    double start = bench_now();
+    for (int t = 0; t < trees; t++) {
+      bst_init(&forest[t]);
+      for (int i = 0; i < count; i++) {
+        bst_insert(&forest[t], keys[i], i);
+      }
+    }
+    double insert_time = bench_now() - start;
+
+    int sum = 0;
+    start = bench_now();
+    for (int i = 0; i < SEARCHES; i++) {
+      int value;
+      if (bst_search(forest[lookups[i] / count], keys[lookups[i] % count],
+                     &value)) {
+        sum += value;
+      }
+    }
+    double search_time = bench_now() - start;
+
+    for (int t = 0; t < trees; t++) {
+      bst_dispose(&forest[t]);
+    }
+
+    printf("%6d %8d %8s %10.1f %10.1f\n", count, trees, "bst",
+           insert_time * 1e9 / TOTAL_NODES, search_time * 1e9 / SEARCHES);
+
+    // Compact trees
+    start = bench_now();
+    for (int t = 0; t < trees; t++) {
+      bstc_init(&compact_forest[t]);
+      for (int i = 0; i < count; i++) {
+        bstc_insert(&compact_forest[t], keys[i], i);
+      }
+    }
+    insert_time = bench_now() - start;
+
+    start = bench_now();
+    for (int i = 0; i < SEARCHES; i++) {
+      int value;
+      if (bstc_search(&compact_forest[lookups[i] / count],
+                      keys[lookups[i] % count], &value)) {
+        sum += value;
+      }
+    }
+    search_time = bench_now() - start;
+    sink = sum;
+
+    for (int t = 0; t < trees; t++) {
+      bstc_dispose(&compact_forest[t]);
+    }
+
+    printf("%6d %8d %8s %10.1f %10.1f\n", count, trees, "compact",
+           insert_time * 1e9 / TOTAL_NODES, search_time * 1e9 / SEARCHES);
+
+    free(lookups);
+    free(forest);
+    free(compact_forest);
+  }
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Benchmark of the generic tree with inlined comparison of the keys against
+ * the same tree comparing the keys through a function pointer (as a tree with
+ * a comparator given at runtime would do).
+ */
+
+#include "../generic/generic.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SEARCHES 2000000
+
+// Number of measured insertions for every tree size
+#define MIN_INSERTS 1000000
+
+int compare_ints(int32_t a, int32_t b) { return BST_GENERIC_CMP(a, b); }
+
+// Pointer isn't constant, so the compiler can't inline the comparator
+int (*compare)(int32_t, int32_t) = compare_ints;
+#define CALL_COMPARE(A, B) compare((A), (B))
+
+BSTDEC(int32_t, int, ptr)
+BSTDEF(int32_t, int, ptr, CALL_COMPARE)
+
+volatile int sink;
+
+/*
+ * Builds the tree from the keys (repeatedly for small trees) and searches the
+ * lookups in it. Generated for both instances, so the loops are the same.
+ */
+#define RUN(TNAME, LABEL)                                                      \
+  {                                                                            \
+    bst_##TNAME##_node_t *tree;                                                \
+    bst_##TNAME##_init(&tree);                                                 \
+    size_t rounds = bench_rounds(count, MIN_INSERTS);                          \
+    double insert_time = 0;                                                    \
+    for (size_t r = 0; r < rounds; r++) {                                      \
+      bst_##TNAME##_dispose(&tree);                                            \
+      double start = bench_now();                                                    \
+      for (size_t i = 0; i < count; i++) {                                     \
+        bst_##TNAME##_insert(&tree, keys[i], (int)i);                          \
+      }                                                                        \
+      insert_time += bench_now() - start;                                            \
+    }                                                                          \
+                                                                               \
+    int sum = 0;                                                               \
+    double start = bench_now();                                                      \
+    for (size_t i = 0; i < SEARCHES; i++) {                                    \
+      int value;                                                               \
+      if (bst_##TNAME##_search(tree, lookups[i], &value)) {                    \
+        sum += value;                                                          \
+      }                                                                        \
+    }                                                                          \
+    double search_time = bench_now() - start;                                        \
+    sink = sum;                                                                \
+    bst_##TNAME##_dispose(&tree);                                              \
+                                                                               \
+    printf("%10zu %10s %10.1f %10.1f\n", count, LABEL,                         \
+           insert_time * 1e9 / ((double)rounds * count),                       \
+           search_time * 1e9 / SEARCHES);                                      \
+  }
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000};
+
+  int32_t *keys = malloc(sizes[2] * sizeof(int32_t));
+  int32_t *lookups = malloc(SEARCHES * sizeof(int32_t));
+  if (keys == NULL || lookups == NULL) {
+    return 1;
+  }
+
+  printf("Nanoseconds per operation (random keys, half of lookups hit)\n\n");
+  printf("%10s %10s %10s %10s\n", "keys", "compare", "insert", "search");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    uint64_t state = 1;
+    for (size_t i = 0; i < count; i++) {
+      keys[i] = (int32_t)(bench_random(&state) % (count * 2));
+    }
+    for (size_t i = 0; i < SEARCHES; i++) {
+      lookups[i] = (int32_t)(bench_random(&state) % (count * 2));
+    }
+
+    RUN(i32, "inlined")
+    RUN(ptr, "pointer")
+  }
+
+  free(keys);
+  free(lookups);
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Benchmark of sorted insertion into the binary search tree.
+ *
+ * Keys are inserted in ascending order, which makes the unbalanced variants
+ * (rec, iter) degenerate into a linked list, and then all of them are
+ * searched. The same file is linked with every variant of btree.c. Keys are
+ * of type char, so the biggest tree has 256 nodes.
+ */
+
+#include "../btree.h"
+#include "bench_util.h"
+#include <limits.h>
+#include <stdio.h>
+
+// Number of measured insertions for every tree size
+#define INSERTS 2000000
+#define SEARCHES 20000000
+
+volatile int sink;
+
+int height(bst_node_t *tree) {
+  if (tree == NULL) {
+    return 0;
+  }
+
+  int left = height(tree->left);
+  int right = height(tree->right);
+  return (left > right ? left : right) + 1;
+}
+
+int main() {
+  const int sizes[] = {16, 32, 64, 128, 256};
+
+  printf("Sorted insertion (nanoseconds per operation)\n\n");
+  printf("%6s %8s %10s %10s\n", "keys", "height", "insert", "search");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    int count = sizes[s];
+    int rounds = (int)bench_rounds((size_t)count, INSERTS);
+    bst_node_t *tree;
+
+    double insert_time = 0;
+    for (int r = 0; r < rounds; r++) {
+      bst_init(&tree);
+      double start = bench_now();
+      for (int i = 0; i < count; i++) {
+        bst_insert(&tree, (char)(CHAR_MIN + i), i);
+      }
+      insert_time += bench_now() - start;
+      bst_dispose(&tree);
+    }
+
+    bst_init(&tree);
+    for (int i = 0; i < count; i++) {
+      bst_insert(&tree, (char)(CHAR_MIN + i), i);
+    }
+
+    int sum = 0;
+    double start = bench_now();
+    for (int i = 0; i < SEARCHES; i++) {
+      int value;
+      if (bst_search(tree, (char)(CHAR_MIN + i % count), &value)) {
+        sum += value;
+      }
+    }
+    double search_time = bench_now() - start;
+    sink = sum;
+
+    printf("%6d %8d %10.1f %10.1f\n", count, height(tree),
+           insert_time * 1e9 / ((double)rounds * count),
+           search_time * 1e9 / SEARCHES);
+
+    bst_dispose(&tree);
+  }
+
+  return 0;
+}
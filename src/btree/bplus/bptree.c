@@ -0,0 +1,453 @@
+/*
+ * B+-tree
+ *
+ * All the values are stored in the leaves, the inner nodes hold only the keys
+ * separating their subtrees. Every node except the root has from BPT_MIN_KEYS
+ * to BPT_KEYS keys, so all the leaves are at the same depth and the height of
+ * the tree is O(log n) with the base about BPT_KEYS.
+ *
+ * Full nodes on the path of the insertion are split into halves before
+ * descending into them, the middle key moves to the parent. Node with too few
+ * keys after the deletion borrows a key from its sibling or it's merged with
+ * it.
+ */
+
+#include "bptree.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Returns number of the keys of the node less than the key.
+ */
+static inline int bpt_lower_bound(const bpt_node_t *node, int key) {
+    // Branch-free counting is faster than binary search in a few cache lines
+    int position = 0;
+    for (int i = 0; i < node->count; i++) {
+        position += node->keys[i] < key;
+    }
+
+    return position;
+}
+
+/*
+ * Returns number of the keys of the node less than or equal to the key, it's
+ * index of the subtree which can contain the key.
+ */
+static inline int bpt_upper_bound(const bpt_node_t *node, int key) {
+    int position = 0;
+    for (int i = 0; i < node->count; i++) {
+        position += node->keys[i] <= key;
+    }
+
+    return position;
+}
+
+static inline bpt_inner_t *bpt_as_inner(bpt_node_t *node) {
+    return (bpt_inner_t *) node;
+}
+
+static inline bpt_leaf_t *bpt_as_leaf(bpt_node_t *node) {
+    return (bpt_leaf_t *) node;
+}
+
+/*
+ * Finds the leaf which can contain the key.
+ */
+static bpt_leaf_t *bpt_find_leaf(bpt_tree_t *tree, int key) {
+    bpt_node_t *node = tree->root;
+    while (!node->leaf) {
+        node = bpt_as_inner(node)->children[bpt_upper_bound(node, key)];
+    }
+
+    return bpt_as_leaf(node);
+}
+
+static bpt_leaf_t *bpt_new_leaf() {
+    bpt_leaf_t *leaf;
+    if ((leaf = malloc(sizeof(bpt_leaf_t))) == NULL) {
+        return NULL;
+    }
+
+    leaf->node.count = 0;
+    leaf->node.leaf = true;
+    leaf->next = NULL;
+
+    return leaf;
+}
+
+static bpt_inner_t *bpt_new_inner() {
+    bpt_inner_t *inner;
+    if ((inner = malloc(sizeof(bpt_inner_t))) == NULL) {
+        return NULL;
+    }
+
+    inner->node.count = 0;
+    inner->node.leaf = false;
+
+    return inner;
+}
+
+/*
+ * Splits the full index-th child of the parent into halves. The parent must
+ * not be full. Returns false if there isn't enough memory (nothing changes).
+ */
+static bool bpt_split_child(bpt_inner_t *parent, int index) {
+    bpt_node_t *child = parent->children[index];
+    bpt_node_t *right;
+    int separator;
+    int half = BPT_KEYS / 2;
+
+    if (child->leaf) {
+        bpt_leaf_t *leaf = bpt_as_leaf(child);
+        bpt_leaf_t *right_leaf;
+        if ((right_leaf = bpt_new_leaf()) == NULL) {
+            return false;
+        }
+
+        // Upper half of the items moves to the new leaf, its first key
+        // separates the leaves
+        right = &right_leaf->node;
+        right->count = (short) (BPT_KEYS - half);
+        memcpy(right->keys, child->keys + half, (size_t) right->count * sizeof(int));
+        memcpy(right_leaf->values, leaf->values + half, (size_t) right->count * sizeof(int));
+        right_leaf->next = leaf->next;
+        leaf->next = right_leaf;
+        separator = right->keys[0];
+    } else {
+        bpt_inner_t *right_inner;
+        if ((right_inner = bpt_new_inner()) == NULL) {
+            return false;
+        }
+
+        // Middle key moves up to the parent, it isn't kept in the halves
+        right = &right_inner->node;
+        right->count = (short) (BPT_KEYS - half - 1);
+        memcpy(right->keys, child->keys + half + 1, (size_t) right->count * sizeof(int));
+        memcpy(right_inner->children, bpt_as_inner(child)->children + half + 1,
+               (size_t) (right->count + 1) * sizeof(bpt_node_t *));
+        separator = child->keys[half];
+    }
+    child->count = (short) half;
+
+    int moved = parent->node.count - index;
+    memmove(parent->node.keys + index + 1, parent->node.keys + index, (size_t) moved * sizeof(int));
+    memmove(parent->children + index + 2, parent->children + index + 1,
+            (size_t) moved * sizeof(bpt_node_t *));
+    parent->node.keys[index] = separator;
+    parent->children[index + 1] = right;
+    parent->node.count++;
+
+    return true;
+}
+
+/*
+ * Moves one item from the sibling to the child which has too few keys, or
+ * merges them if the sibling can't give any. The child is the index-th
+ * subtree of the parent.
+ */
+static void bpt_fix_child(bpt_inner_t *parent, int index) {
+    bpt_node_t *child = parent->children[index];
+    bpt_node_t *left = index > 0 ? parent->children[index - 1] : NULL;
+    bpt_node_t *right = index < parent->node.count ? parent->children[index + 1] : NULL;
+
+    if (left != NULL && left->count > BPT_MIN_KEYS) {
+        // Last item of the left sibling becomes the first item of the child
+        memmove(child->keys + 1, child->keys, (size_t) child->count * sizeof(int));
+        if (child->leaf) {
+            bpt_leaf_t *leaf = bpt_as_leaf(child);
+            memmove(leaf->values + 1, leaf->values, (size_t) child->count * sizeof(int));
+            child->keys[0] = left->keys[left->count - 1];
+            leaf->values[0] = bpt_as_leaf(left)->values[left->count - 1];
+            parent->node.keys[index - 1] = child->keys[0];
+        } else {
+            bpt_inner_t *inner = bpt_as_inner(child);
+            memmove(inner->children + 1, inner->children,
+                    (size_t) (child->count + 1) * sizeof(bpt_node_t *));
+            child->keys[0] = parent->node.keys[index - 1];
+            inner->children[0] = bpt_as_inner(left)->children[left->count];
+            parent->node.keys[index - 1] = left->keys[left->count - 1];
+        }
+        child->count++;
+        left->count--;
+
+        return;
+    }
+
+    if (right != NULL && right->count > BPT_MIN_KEYS) {
+        // First item of the right sibling becomes the last item of the child
+        if (child->leaf) {
+            bpt_leaf_t *leaf = bpt_as_leaf(child);
+            bpt_leaf_t *right_leaf = bpt_as_leaf(right);
+            child->keys[child->count] = right->keys[0];
+            leaf->values[child->count] = right_leaf->values[0];
+            memmove(right_leaf->values, right_leaf->values + 1,
+                    (size_t) (right->count - 1) * sizeof(int));
+            memmove(right->keys, right->keys + 1, (size_t) (right->count - 1) * sizeof(int));
+            parent->node.keys[index] = right->keys[0];
+        } else {
+            bpt_inner_t *right_inner = bpt_as_inner(right);
+            child->keys[child->count] = parent->node.keys[index];
+            bpt_as_inner(child)->children[child->count + 1] = right_inner->children[0];
+            parent->node.keys[index] = right->keys[0];
+            memmove(right->keys, right->keys + 1, (size_t) (right->count - 1) * sizeof(int));
+            memmove(right_inner->children, right_inner->children + 1,
+                    (size_t) right->count * sizeof(bpt_node_t *));
+        }
+        child->count++;
+        right->count--;
+
+        return;
+    }
+
+    // Neither sibling can give an item --> merge the child with one of them
+    if (left == NULL) {
+        left = child;
+        index++;
+    }
+    right = parent->children[index];
+
+    if (left->leaf) {
+        bpt_leaf_t *left_leaf = bpt_as_leaf(left);
+        bpt_leaf_t *right_leaf = bpt_as_leaf(right);
+        memcpy(left->keys + left->count, right->keys, (size_t) right->count * sizeof(int));
+        memcpy(left_leaf->values + left->count, right_leaf->values, (size_t) right->count * sizeof(int));
+        left->count = (short) (left->count + right->count);
+        left_leaf->next = right_leaf->next;
+    } else {
+        // Separator from the parent goes down between the keys of the nodes
+        bpt_inner_t *left_inner = bpt_as_inner(left);
+        left->keys[left->count] = parent->node.keys[index - 1];
+        memcpy(left->keys + left->count + 1, right->keys, (size_t) right->count * sizeof(int));
+        memcpy(left_inner->children + left->count + 1, bpt_as_inner(right)->children,
+               (size_t) (right->count + 1) * sizeof(bpt_node_t *));
+        left->count = (short) (left->count + right->count + 1);
+    }
+    free(right);
+
+    // Separator and the right node are removed from the parent
+    int moved = parent->node.count - index;
+    memmove(parent->node.keys + index - 1, parent->node.keys + index, (size_t) moved * sizeof(int));
+    memmove(parent->children + index, parent->children + index + 1,
+            (size_t) moved * sizeof(bpt_node_t *));
+    parent->node.count--;
+}
+
+/*
+ * Deletes the key from the subtree. The node can have too few keys afterwards,
+ * its parent fixes it.
+ */
+static void bpt_delete_node(bpt_tree_t *tree, bpt_node_t *node, int key) {
+    if (node->leaf) {
+        bpt_leaf_t *leaf = bpt_as_leaf(node);
+        int position = bpt_lower_bound(node, key);
+        if (position == node->count || node->keys[position] != key) {
+            // Key isn't in the tree --> nothing to do
+            return;
+        }
+
+        int moved = node->count - position - 1;
+        memmove(node->keys + position, node->keys + position + 1, (size_t) moved * sizeof(int));
+        memmove(leaf->values + position, leaf->values + position + 1, (size_t) moved * sizeof(int));
+        node->count--;
+        tree->count--;
+
+        return;
+    }
+
+    // Separators can stay even if their keys are deleted, they still separate
+    // the subtrees correctly
+    bpt_inner_t *inner = bpt_as_inner(node);
+    int position = bpt_upper_bound(node, key);
+    bpt_delete_node(tree, inner->children[position], key);
+    if (inner->children[position]->count < BPT_MIN_KEYS) {
+        bpt_fix_child(inner, position);
+    }
+}
+
+static void bpt_dispose_node(bpt_node_t *node) {
+    if (!node->leaf) {
+        bpt_inner_t *inner = bpt_as_inner(node);
+        for (int i = 0; i <= node->count; i++) {
+            bpt_dispose_node(inner->children[i]);
+        }
+    }
+
+    free(node);
+}
+
+/*
+ * Initialization of the tree — call it before the first usage of the tree.
+ */
+void bpt_init(bpt_tree_t *tree) {
+    tree->root = NULL;
+    tree->count = 0;
+    tree->height = 0;
+}
+
+/*
+ * Searching for the key in the tree.
+ *
+ * If the key is found, its value is stored to the value parameter and true is
+ * returned. Otherwise false is returned and value isn't changed.
+ */
+bool bpt_search(bpt_tree_t *tree, int key, int *value) {
+    if (tree->root == NULL) {
+        return false;
+    }
+
+    bpt_leaf_t *leaf = bpt_find_leaf(tree, key);
+    int position = bpt_lower_bound(&leaf->node, key);
+    if (position == leaf->node.count || leaf->node.keys[position] != key) {
+        return false;
+    }
+
+    *value = leaf->values[position];
+    return true;
+}
+
+/*
+ * Inserting an item into the tree.
+ *
+ * If there already is an item with the key, only its value is replaced.
+ */
+void bpt_insert(bpt_tree_t *tree, int key, int value) {
+    if (tree->root == NULL) {
+        bpt_leaf_t *leaf;
+        if ((leaf = bpt_new_leaf()) == NULL) {
+            return;
+        }
+
+        tree->root = &leaf->node;
+        tree->height = 1;
+    }
+
+    if (tree->root->count == BPT_KEYS) {
+        // Full root is split under a new root, the tree grows by one level
+        bpt_inner_t *root;
+        if ((root = bpt_new_inner()) == NULL) {
+            return;
+        }
+
+        root->children[0] = tree->root;
+        if (!bpt_split_child(root, 0)) {
+            free(root);
+            return;
+        }
+
+        tree->root = &root->node;
+        tree->height++;
+    }
+
+    // Full nodes are split on the way down, so the parent of a split node
+    // always has a free slot for the separator
+    bpt_node_t *node = tree->root;
+    while (!node->leaf) {
+        bpt_inner_t *inner = bpt_as_inner(node);
+        int position = bpt_upper_bound(node, key);
+        if (inner->children[position]->count == BPT_KEYS) {
+            if (!bpt_split_child(inner, position)) {
+                return;
+            }
+
+            if (key >= node->keys[position]) {
+                position++;
+            }
+        }
+
+        node = inner->children[position];
+    }
+
+    bpt_leaf_t *leaf = bpt_as_leaf(node);
+    int position = bpt_lower_bound(node, key);
+    if (position < node->count && node->keys[position] == key) {
+        // Key is already in the tree --> only edit value
+        leaf->values[position] = value;
+
+        return;
+    }
+
+    int moved = node->count - position;
+    memmove(node->keys + position + 1, node->keys + position, (size_t) moved * sizeof(int));
+    memmove(leaf->values + position + 1, leaf->values + position, (size_t) moved * sizeof(int));
+    node->keys[position] = key;
+    leaf->values[position] = value;
+    node->count++;
+    tree->count++;
+}
+
+/*
+ * Deleting the item from the tree.
+ *
+ * If there is no item with the key, nothing happens.
+ */
+void bpt_delete(bpt_tree_t *tree, int key) {
+    if (tree->root == NULL) {
+        return;
+    }
+
+    bpt_delete_node(tree, tree->root, key);
+
+    bpt_node_t *root = tree->root;
+    if (root->count == 0) {
+        // Empty root is removed, the tree shrinks by one level
+        tree->root = root->leaf ? NULL : bpt_as_inner(root)->children[0];
+        tree->height--;
+        free(root);
+    }
+}
+
+/*
+ * Disposing of the whole tree.
+ *
+ * All the nodes are released and the tree is in the same state as after the
+ * initialization.
+ */
+void bpt_dispose(bpt_tree_t *tree) {
+    if (tree->root != NULL) {
+        bpt_dispose_node(tree->root);
+    }
+
+    bpt_init(tree);
+}
+
+/*
+ * Initialization of the cursor at the first item with key greater than or
+ * equal to from.
+ *
+ * The cursor is valid until the next modification of the tree.
+ */
+void bpt_cursor_init(bpt_tree_t *tree, bpt_cursor_t *cursor, int from) {
+    if (tree->root == NULL) {
+        cursor->leaf = NULL;
+        cursor->index = 0;
+
+        return;
+    }
+
+    cursor->leaf = bpt_find_leaf(tree, from);
+    cursor->index = bpt_lower_bound(&cursor->leaf->node, from);
+}
+
+/*
+ * Moving the cursor to the next item in the order of the keys.
+ *
+ * Stores the key and the value of the current item and returns true, or
+ * returns false if there are no more items.
+ */
+bool bpt_cursor_next(bpt_cursor_t *cursor, int *key, int *value) {
+    // Leaves are linked, so the scan doesn't return to the inner nodes
+    while (cursor->leaf != NULL && cursor->index == cursor->leaf->node.count) {
+        cursor->leaf = cursor->leaf->next;
+        cursor->index = 0;
+    }
+
+    if (cursor->leaf == NULL) {
+        return false;
+    }
+
+    *key = cursor->leaf->node.keys[cursor->index];
+    *value = cursor->leaf->values[cursor->index];
+    cursor->index++;
+
+    return true;
+}
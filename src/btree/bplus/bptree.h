@@ -0,0 +1,67 @@
+/*
+ * Header file for the B+-tree.
+ *
+ * Unlike bst_node_t with one key per node, every node of the B+-tree holds up
+ * to BPT_KEYS sorted keys, so one visited node (a few cache lines) replaces
+ * several levels of the binary tree. Values are stored only in the leaves,
+ * which are linked in the order of their keys for range scans.
+ *
+ * Operations have the same semantics as bst_init/insert/search/delete/dispose,
+ * keys are of type int.
+ */
+
+#ifndef IAL_BTREE_BPTREE_H
+#define IAL_BTREE_BPTREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Maximum number of keys in a node (a leaf takes 256 bytes)
+#define BPT_KEYS 30
+
+// Minimum number of keys in a node other than root
+#define BPT_MIN_KEYS ((BPT_KEYS - 1) / 2)
+
+// Part of the node shared by the leaves and the inner nodes
+typedef struct bpt_node {
+  short count;        // number of keys
+  bool leaf;          // true if the node is a leaf
+  int keys[BPT_KEYS]; // sorted keys
+} bpt_node_t;
+
+// Inner node, its i-th subtree contains keys from keys[i-1] to keys[i]
+typedef struct bpt_inner {
+  bpt_node_t node;                    // keys separating the subtrees
+  bpt_node_t *children[BPT_KEYS + 1]; // subtrees
+} bpt_inner_t;
+
+// Leaf holding the values of its keys
+typedef struct bpt_leaf {
+  bpt_node_t node;       // keys of the values
+  int values[BPT_KEYS];  // values
+  struct bpt_leaf *next; // leaf with the following keys, NULL if none
+} bpt_leaf_t;
+
+// B+-tree
+typedef struct bpt_tree {
+  bpt_node_t *root; // root node, NULL if the tree is empty
+  size_t count;     // number of stored keys
+  int height;       // number of levels (0 for an empty tree)
+} bpt_tree_t;
+
+// Position in the ordered sequence of the items
+typedef struct bpt_cursor {
+  bpt_leaf_t *leaf; // current leaf, NULL at the end
+  int index;        // index of the next item in the leaf
+} bpt_cursor_t;
+
+void bpt_init(bpt_tree_t *tree);
+void bpt_insert(bpt_tree_t *tree, int key, int value);
+bool bpt_search(bpt_tree_t *tree, int key, int *value);
+void bpt_delete(bpt_tree_t *tree, int key);
+void bpt_dispose(bpt_tree_t *tree);
+
+void bpt_cursor_init(bpt_tree_t *tree, bpt_cursor_t *cursor, int from);
+bool bpt_cursor_next(bpt_cursor_t *cursor, int *key, int *value);
+
+#endif
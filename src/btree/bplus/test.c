@@ -0,0 +1,192 @@
+#include "bptree.h"
+#include <stdio.h>
+
+#define TEST(NAME, DESCRIPTION)                                                \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    bpt_tree_t test_tree;                                                      \
+    bpt_init(&test_tree);
+
+#define ENDTEST                                                                \
+  printf("\n");                                                                \
+  bpt_dispose(&test_tree);                                                     \
+  }
+
+void print_level(bpt_node_t *node, int depth) {
+  if (depth > 0) {
+    bpt_inner_t *inner = (bpt_inner_t *)node;
+    for (int i = 0; i <= node->count; i++) {
+      print_level(inner->children[i], depth - 1);
+    }
+  } else if (node->leaf) {
+    printf("[%d..%d]", node->keys[0], node->keys[node->count - 1]);
+  } else {
+    printf("(");
+    for (int i = 0; i < node->count; i++) {
+      printf(i == 0 ? "%d" : " %d", node->keys[i]);
+    }
+    printf(")");
+  }
+}
+
+void print_tree(bpt_tree_t *tree) {
+  printf("B+ tree structure (%zu items, height %d):\n", tree->count,
+         tree->height);
+  if (tree->root == NULL) {
+    printf("Tree is empty\n");
+  }
+  for (int depth = 0; depth < tree->height; depth++) {
+    print_level(tree->root, depth);
+    printf("\n");
+  }
+  printf("\n");
+}
+
+void insert_range(bpt_tree_t *tree, int first, int last, int step) {
+  for (int key = first; step > 0 ? key <= last : key >= last; key += step) {
+    bpt_insert(tree, key, key * 10);
+  }
+}
+
+void delete_range(bpt_tree_t *tree, int first, int last, int step) {
+  for (int key = first; step > 0 ? key <= last : key >= last; key += step) {
+    bpt_delete(tree, key);
+  }
+}
+
+void print_search(bpt_tree_t *tree, int key) {
+  int value = -1234;
+  bool found = bpt_search(tree, key, &value);
+  printf("Search %d: %s, value %d\n", key, found ? "found" : "not found",
+         value);
+}
+
+TEST(test_init, "Initialize the tree")
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_search_empty, "Search in an empty tree (1)")
+print_search(&test_tree, 1);
+ENDTEST
+
+TEST(test_insert_root, "Insert an item (1,10)")
+bpt_insert(&test_tree, 1, 10);
+print_search(&test_tree, 1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_update, "Update an item (1,10)->(1,8)")
+bpt_insert(&test_tree, 1, 10);
+bpt_insert(&test_tree, 1, 8);
+print_search(&test_tree, 1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_split_leaf, "Insert one more item than fits into a leaf")
+insert_range(&test_tree, 1, BPT_KEYS + 1, 1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_insert_sorted, "Insert 200 keys in ascending order")
+insert_range(&test_tree, 1, 200, 1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_insert_reversed, "Insert 200 keys in descending order")
+insert_range(&test_tree, 200, 1, -1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_insert_many, "Insert 1000 keys in mixed order (three levels)")
+for (int i = 0; i < 1000; i++) {
+  int key = (i * 389) % 1000;
+  bpt_insert(&test_tree, key, key * 10);
+}
+print_tree(&test_tree);
+print_search(&test_tree, 0);
+print_search(&test_tree, 999);
+print_search(&test_tree, 1000);
+print_search(&test_tree, -1);
+ENDTEST
+
+TEST(test_delete_missing, "Delete a missing key (0)")
+insert_range(&test_tree, 1, 40, 1);
+bpt_delete(&test_tree, 0);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_delete_borrow, "Delete keys until a leaf borrows from its sibling")
+insert_range(&test_tree, 1, 40, 1);
+print_tree(&test_tree);
+bpt_delete(&test_tree, 1);
+bpt_delete(&test_tree, 2);
+print_tree(&test_tree);
+print_search(&test_tree, 2);
+print_search(&test_tree, 3);
+ENDTEST
+
+TEST(test_delete_merge, "Delete keys until leaves are merged")
+insert_range(&test_tree, 1, 200, 1);
+delete_range(&test_tree, 1, 60, 1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_delete_shrink, "Delete keys until the tree shrinks")
+insert_range(&test_tree, 1, 1000, 1);
+print_tree(&test_tree);
+delete_range(&test_tree, 1000, 31, -1);
+print_tree(&test_tree);
+delete_range(&test_tree, 1, 30, 1);
+print_tree(&test_tree);
+ENDTEST
+
+TEST(test_scan, "Scan the items from key 93 by a cursor")
+insert_range(&test_tree, 0, 200, 5);
+bpt_cursor_t cursor;
+bpt_cursor_init(&test_tree, &cursor, 93);
+int key, value;
+while (bpt_cursor_next(&cursor, &key, &value)) {
+  printf("[%d,%d]", key, value);
+}
+printf("\n");
+ENDTEST
+
+TEST(test_scan_empty, "Scan an empty tree and behind the last key")
+bpt_cursor_t cursor;
+int key, value;
+bpt_cursor_init(&test_tree, &cursor, 0);
+printf("Empty tree: %s\n",
+       bpt_cursor_next(&cursor, &key, &value) ? "item" : "end");
+insert_range(&test_tree, 1, 100, 1);
+bpt_cursor_init(&test_tree, &cursor, 101);
+printf("Behind the last key: %s\n",
+       bpt_cursor_next(&cursor, &key, &value) ? "item" : "end");
+ENDTEST
+
+TEST(test_dispose, "Dispose the whole tree")
+insert_range(&test_tree, 1, 1000, 1);
+bpt_dispose(&test_tree);
+print_tree(&test_tree);
+ENDTEST
+
+int main() {
+  printf("B+ Tree - testing script\n");
+  printf("------------------------\n");
+  printf("\n");
+
+  test_init();
+  test_search_empty();
+  test_insert_root();
+  test_update();
+  test_split_leaf();
+  test_insert_sorted();
+  test_insert_reversed();
+  test_insert_many();
+  test_delete_missing();
+  test_delete_borrow();
+  test_delete_merge();
+  test_delete_shrink();
+  test_scan();
+  test_scan_empty();
+  test_dispose();
+}
@@ -0,0 +1,346 @@
+/*
+ * Compact binary search tree
+ *
+ * Nodes are allocated from the array of the tree: released nodes are linked
+ * into a free list by their left indices and reused first, the array is
+ * doubled when all of its items are used. Indices (unlike pointers) stay valid
+ * when the array is moved by realloc. The array is released at once by
+ * bstc_dispose.
+ */
+
+#include "compact.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Number of the nodes allocated for a new tree
+#define BSTC_INITIAL_CAPACITY 16
+
+/*
+ * Returns index of a new node with the key and value and no children, or
+ * BSTC_NIL if there isn't enough memory. The array of the nodes can be moved.
+ */
+static bstc_index_t bstc_new_node(bstc_tree_t *tree, char key, int value) {
+    bstc_index_t index = tree->free;
+    if (index != BSTC_NIL) {
+        tree->free = tree->nodes[index].left;
+    } else {
+        if (tree->used == tree->capacity) {
+            if (tree->capacity > BSTC_NIL / 2) {
+                // Indices would overflow
+                return BSTC_NIL;
+            }
+
+            bstc_index_t capacity = tree->capacity != 0 ? tree->capacity * 2
+                                                        : BSTC_INITIAL_CAPACITY;
+            bstc_node_t *nodes = realloc(tree->nodes, (size_t) capacity * sizeof(bstc_node_t));
+            if (nodes == NULL) {
+                return BSTC_NIL;
+            }
+
+            tree->nodes = nodes;
+            tree->capacity = capacity;
+        }
+
+        index = tree->used++;
+    }
+
+    bstc_node_t *node = &tree->nodes[index];
+    node->key = key;
+    node->value = value;
+    node->left = BSTC_NIL;
+    node->right = BSTC_NIL;
+
+    return index;
+}
+
+static void bstc_release_node(bstc_tree_t *tree, bstc_index_t index) {
+    if (tree->root == BSTC_NIL) {
+        // Last node of the tree --> the whole array can be reused from start
+        tree->used = 0;
+        tree->free = BSTC_NIL;
+        return;
+    }
+
+    tree->nodes[index].left = tree->free;
+    tree->free = index;
+}
+
+void bstc_init(bstc_tree_t *tree) {
+    tree->nodes = NULL;
+    tree->root = BSTC_NIL;
+    tree->used = 0;
+    tree->capacity = 0;
+    tree->free = BSTC_NIL;
+}
+
+/*
+ * Finds the key in the tree and stores its value to the value. Returns false
+ * (and value isn't changed) if the key isn't in the tree.
+ */
+bool bstc_search(const bstc_tree_t *tree, char key, int *value) {
+    bstc_index_t index = tree->root;
+    while (index != BSTC_NIL) {
+        const bstc_node_t *node = &tree->nodes[index];
+        if (node->key == key) {
+            *value = node->value;
+            return true;
+        }
+
+        index = key < node->key ? node->left : node->right;
+    }
+
+    return false;
+}
+
+/*
+ * Inserts the key with the value into the tree as a new leaf, or replaces the
+ * value if the key is already in the tree.
+ */
+void bstc_insert(bstc_tree_t *tree, char key, int value) {
+    bstc_index_t parent = BSTC_NIL;
+    bstc_index_t index = tree->root;
+    while (index != BSTC_NIL) {
+        bstc_node_t *node = &tree->nodes[index];
+        if (node->key == key) {
+            node->value = value;
+            return;
+        }
+
+        parent = index;
+        index = key < node->key ? node->left : node->right;
+    }
+
+    // Parent is linked by its index, the array can be moved by the allocation
+    bstc_index_t leaf = bstc_new_node(tree, key, value);
+    if (leaf == BSTC_NIL) {
+        return;
+    }
+
+    if (parent == BSTC_NIL) {
+        tree->root = leaf;
+    } else if (key < tree->nodes[parent].key) {
+        tree->nodes[parent].left = leaf;
+    } else {
+        tree->nodes[parent].right = leaf;
+    }
+}
+
+/*
+ * Deletes the key from the tree, nothing happens if it isn't in the tree.
+ * Node with both subtrees is replaced by the rightmost node of its left
+ * subtree.
+ */
+void bstc_delete(bstc_tree_t *tree, char key) {
+    // Link (root or child index of the parent) to the node with the key
+    bstc_index_t *link = &tree->root;
+    while (*link != BSTC_NIL && tree->nodes[*link].key != key) {
+        bstc_node_t *node = &tree->nodes[*link];
+        link = key < node->key ? &node->left : &node->right;
+    }
+
+    bstc_index_t index = *link;
+    if (index == BSTC_NIL) {
+        return;
+    }
+
+    bstc_node_t *node = &tree->nodes[index];
+    if (node->left == BSTC_NIL || node->right == BSTC_NIL) {
+        // The only subtree (if any) is inherited by the parent
+        *link = node->left != BSTC_NIL ? node->left : node->right;
+        bstc_release_node(tree, index);
+        return;
+    }
+
+    // Both subtrees --> move the rightmost node of the left one here
+    bstc_index_t *rightmost_link = &node->left;
+    while (tree->nodes[*rightmost_link].right != BSTC_NIL) {
+        rightmost_link = &tree->nodes[*rightmost_link].right;
+    }
+
+    bstc_index_t rightmost = *rightmost_link;
+    node->key = tree->nodes[rightmost].key;
+    node->value = tree->nodes[rightmost].value;
+    *rightmost_link = tree->nodes[rightmost].left;
+    bstc_release_node(tree, rightmost);
+}
+
+/*
+ * Deletes all the nodes of the tree, it's in the same state as after
+ * bstc_init.
+ */
+void bstc_dispose(bstc_tree_t *tree) {
+    free(tree->nodes);
+    bstc_init(tree);
+}
+
+static void bstc_preorder_node(const bstc_tree_t *tree, bstc_index_t index) {
+    if (index != BSTC_NIL) {
+        bstc_print_node(&tree->nodes[index]);
+        bstc_preorder_node(tree, tree->nodes[index].left);
+        bstc_preorder_node(tree, tree->nodes[index].right);
+    }
+}
+
+static void bstc_inorder_node(const bstc_tree_t *tree, bstc_index_t index) {
+    if (index != BSTC_NIL) {
+        bstc_inorder_node(tree, tree->nodes[index].left);
+        bstc_print_node(&tree->nodes[index]);
+        bstc_inorder_node(tree, tree->nodes[index].right);
+    }
+}
+
+static void bstc_postorder_node(const bstc_tree_t *tree, bstc_index_t index) {
+    if (index != BSTC_NIL) {
+        bstc_postorder_node(tree, tree->nodes[index].left);
+        bstc_postorder_node(tree, tree->nodes[index].right);
+        bstc_print_node(&tree->nodes[index]);
+    }
+}
+
+void bstc_preorder(const bstc_tree_t *tree) {
+    bstc_preorder_node(tree, tree->root);
+}
+
+void bstc_inorder(const bstc_tree_t *tree) {
+    bstc_inorder_node(tree, tree->root);
+}
+
+void bstc_postorder(const bstc_tree_t *tree) {
+    bstc_postorder_node(tree, tree->root);
+}
+
+/*
+ * Writes the tree to the binary file: bstc_file_header_t followed by the used
+ * part of the array, every node as its value, left and right index and key
+ * (in the byte order of the platform). Returns false if the writing fails.
+ */
+bool bstc_save(const bstc_tree_t *tree, FILE *file) {
+    bstc_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BSTC_MAGIC, sizeof(header.magic));
+    header.version = BSTC_VERSION;
+    header.byte_order = BSTC_BYTE_ORDER;
+    header.root = tree->root;
+    header.used = tree->used;
+    header.free = tree->free;
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        return false;
+    }
+
+    for (bstc_index_t i = 0; i < tree->used; i++) {
+        const bstc_node_t *node = &tree->nodes[i];
+        unsigned char record[BSTC_RECORD_SIZE];
+        memcpy(record, &node->value, sizeof(int));
+        memcpy(record + sizeof(int), &node->left, sizeof(bstc_index_t));
+        memcpy(record + sizeof(int) + sizeof(bstc_index_t), &node->right, sizeof(bstc_index_t));
+        record[BSTC_RECORD_SIZE - 1] = (unsigned char) node->key;
+        if (fwrite(record, sizeof(record), 1, file) != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Checks that the nodes reachable from the root and the released nodes of the
+ * free list are all the used nodes of the array, each of them reached exactly
+ * once. Then no function leaves the array or loops.
+ */
+static bool bstc_valid(const bstc_tree_t *tree) {
+    bool *reached = calloc((size_t) tree->used + 1, sizeof(bool));
+    bstc_index_t *stack = malloc(((size_t) tree->used + 1) * sizeof(bstc_index_t));
+    bool valid = reached != NULL && stack != NULL;
+
+    // Stack holds at most one node more than the reached ones, unless a node
+    // is reached twice
+    size_t count = 0;
+    size_t top = 0;
+    if (valid && tree->root != BSTC_NIL) {
+        stack[top++] = tree->root;
+    }
+    while (valid && top > 0) {
+        bstc_index_t index = stack[--top];
+        if (index >= tree->used || reached[index] || top + 2 > (size_t) tree->used + 1) {
+            valid = false;
+            break;
+        }
+
+        reached[index] = true;
+        count++;
+        if (tree->nodes[index].left != BSTC_NIL) {
+            stack[top++] = tree->nodes[index].left;
+        }
+        if (tree->nodes[index].right != BSTC_NIL) {
+            stack[top++] = tree->nodes[index].right;
+        }
+    }
+
+    for (bstc_index_t index = tree->free; valid && index != BSTC_NIL; index = tree->nodes[index].left) {
+        if (index >= tree->used || reached[index]) {
+            valid = false;
+            break;
+        }
+
+        reached[index] = true;
+        count++;
+    }
+
+    free(reached);
+    free(stack);
+
+    return valid && count == tree->used;
+}
+
+/*
+ * Reads the tree written by bstc_save into the tree, which mustn't contain any
+ * nodes. Returns false (and the tree is empty) if the file can't be read or
+ * it doesn't contain a tree: the header doesn't match, the nodes are
+ * truncated, or their indices don't form a tree and a free list.
+ */
+bool bstc_load(bstc_tree_t *tree, FILE *file) {
+    bstc_init(tree);
+
+    bstc_file_header_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, BSTC_MAGIC, sizeof(header.magic)) != 0
+        || header.version != BSTC_VERSION || header.byte_order != BSTC_BYTE_ORDER
+        || header.used == BSTC_NIL) {
+        return false;
+    }
+
+    if (header.used != 0) {
+        if ((tree->nodes = malloc((size_t) header.used * sizeof(bstc_node_t))) == NULL) {
+            return false;
+        }
+
+        for (bstc_index_t i = 0; i < header.used; i++) {
+            bstc_node_t *node = &tree->nodes[i];
+            unsigned char record[BSTC_RECORD_SIZE];
+            if (fread(record, sizeof(record), 1, file) != 1) {
+                bstc_dispose(tree);
+                return false;
+            }
+
+            memcpy(&node->value, record, sizeof(int));
+            memcpy(&node->left, record + sizeof(int), sizeof(bstc_index_t));
+            memcpy(&node->right, record + sizeof(int) + sizeof(bstc_index_t), sizeof(bstc_index_t));
+            node->key = (char) record[BSTC_RECORD_SIZE - 1];
+        }
+    }
+
+    tree->root = header.root;
+    tree->used = header.used;
+    tree->capacity = header.used;
+    tree->free = header.free;
+    if (!bstc_valid(tree)) {
+        bstc_dispose(tree);
+        return false;
+    }
+
+    return true;
+}
+
+void bstc_print_node(const bstc_node_t *node) {
+    printf("[%c,%d]", node->key, node->value);
+}
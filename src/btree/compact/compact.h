@@ -0,0 +1,82 @@
+/*
+ * Header file for the compact binary search tree.
+ *
+ * Nodes of the tree are stored in one growable array and they refer to their
+ * children by 32-bit indices into it instead of pointers, so a node takes 16
+ * bytes instead of 24 bytes of bst_node_t on 64-bit platforms. The tree
+ * contains no pointers except the array itself: it can be moved by realloc or
+ * memcpy, and bstc_save writes the nodes to a file without any translation.
+ *
+ * Operations have the same semantics as the functions of btree.h (tree shapes
+ * after insertions and deletions are the same as in rec and iter variants).
+ */
+
+#ifndef IAL_BTREE_COMPACT_H
+#define IAL_BTREE_COMPACT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Index of a node in the array of the tree
+typedef uint32_t bstc_index_t;
+
+// Index of no node (empty subtree)
+#define BSTC_NIL UINT32_MAX
+
+// Node of the tree
+typedef struct bstc_node {
+  int value;          // value
+  bstc_index_t left;  // left child
+  bstc_index_t right; // right child
+  char key;           // key
+} bstc_node_t;
+
+// Identification of the files written by bstc_save
+#define BSTC_MAGIC "IALBSTCT"
+
+// Version of the file format
+#define BSTC_VERSION 1
+
+// Written in the byte order of the writer, read back the same only by readers
+// with the same byte order
+#define BSTC_BYTE_ORDER 0x01020304
+
+// Header of the file, followed by the used nodes
+typedef struct bstc_file_header {
+  char magic[8];       // BSTC_MAGIC (without the terminating zero)
+  uint32_t version;    // BSTC_VERSION
+  uint32_t byte_order; // BSTC_BYTE_ORDER
+  bstc_index_t root;   // root node
+  bstc_index_t used;   // number of the nodes in the file
+  bstc_index_t free;   // first released node
+} bstc_file_header_t;
+
+// Size of a node in the file: value, left, right and key without the padding
+#define BSTC_RECORD_SIZE (sizeof(int) + 2 * sizeof(bstc_index_t) + 1)
+
+// Tree
+typedef struct bstc_tree {
+  bstc_node_t *nodes;    // array of the nodes, NULL if the tree is empty
+  bstc_index_t root;     // root node, BSTC_NIL if the tree is empty
+  bstc_index_t used;     // number of the used items of the array
+  bstc_index_t capacity; // number of the allocated items of the array
+  bstc_index_t free;     // released node linked by left, BSTC_NIL if none
+} bstc_tree_t;
+
+void bstc_init(bstc_tree_t *tree);
+void bstc_insert(bstc_tree_t *tree, char key, int value);
+bool bstc_search(const bstc_tree_t *tree, char key, int *value);
+void bstc_delete(bstc_tree_t *tree, char key);
+void bstc_dispose(bstc_tree_t *tree);
+
+void bstc_preorder(const bstc_tree_t *tree);
+void bstc_inorder(const bstc_tree_t *tree);
+void bstc_postorder(const bstc_tree_t *tree);
+
+bool bstc_save(const bstc_tree_t *tree, FILE *file);
+bool bstc_load(bstc_tree_t *tree, FILE *file);
+
+void bstc_print_node(const bstc_node_t *node);
+
+#endif
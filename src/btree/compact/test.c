@@ -0,0 +1,154 @@
+/*
+ * Testing script of the compact tree.
+ *
+ * The scenarios of ../test.c are compiled unchanged: the headers included by
+ * it are replaced by this file (their include guards are defined below) and
+ * the bst_* calls are mapped to the bstc_* functions. Every printed tree is
+ * first written to a temporary file by bstc_save and read back by bstc_load,
+ * so the output checks the serialization too. The scenarios disposing a
+ * subtree are skipped (nodes of the compact tree aren't trees by themselves)
+ * and test_load_corrupted is added at the end, otherwise the output is the
+ * same as ../btree.out.
+ */
+#include "compact.h"
+#include "../test_util_print.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IAL_BTREE_H
+#define IAL_BTREE_TEST_UTIL_H
+#define BST_NO_SUBTREES
+
+#define TEST(NAME, DESCRIPTION)                                                \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    bstc_tree_t test_tree;
+
+#define ENDTEST                                                                \
+  printf("\n");                                                                \
+  bstc_dispose(&test_tree);                                                    \
+  }
+
+#define bst_init(TREE) bstc_init(TREE)
+#define bst_insert(TREE, KEY, VALUE) bstc_insert(TREE, KEY, VALUE)
+#define bst_search(TREE, KEY, VALUE) bstc_search(&(TREE), KEY, VALUE)
+#define bst_delete(TREE, KEY) bstc_delete(TREE, KEY)
+#define bst_dispose(TREE) bstc_dispose(TREE)
+#define bst_preorder(TREE) bstc_preorder(&(TREE))
+#define bst_inorder(TREE) bstc_inorder(&(TREE))
+#define bst_postorder(TREE) bstc_postorder(&(TREE))
+#define bst_print_tree(TREE) print_tree(&(TREE))
+#define bst_insert_many(TREE, KEYS, VALUES, COUNT)                             \
+  insert_many(TREE, KEYS, VALUES, COUNT)
+
+const void *child(const void *tree, const void *node, direction_t side) {
+  const bstc_tree_t *compact = tree;
+  const bstc_node_t *parent = node;
+  bstc_index_t index = side == left ? parent->left : parent->right;
+  return index != BSTC_NIL ? &compact->nodes[index] : NULL;
+}
+
+void print_node(const void *tree, const void *node) {
+  (void)tree;
+  bstc_print_node(node);
+}
+
+void print_tree(const bstc_tree_t *tree) {
+  bstc_tree_t copy;
+  FILE *file = tmpfile();
+  if (file == NULL || !bstc_save(tree, file) || fseek(file, 0, SEEK_SET) != 0 ||
+      !bstc_load(&copy, file)) {
+    printf("Serialization failed\n");
+    exit(1);
+  }
+  fclose(file);
+
+  printf("Binary tree structure:\n");
+  printf("\n");
+  if (copy.root != BSTC_NIL) {
+    tree_printer_t printer = {&copy, child, print_node};
+    print_subtree(&printer, &copy.nodes[copy.root], "", none);
+  } else {
+    printf("Tree is empty\n");
+  }
+  printf("\n");
+
+  bstc_dispose(&copy);
+}
+
+void insert_many(bstc_tree_t *tree, const char keys[], const int values[],
+                 int count) {
+  for (int i = 0; i < count; i++) {
+    bstc_insert(tree, keys[i], values[i]);
+  }
+}
+
+// Scenarios of the compact tree run after the ones of ../test.c
+void test_load_corrupted();
+#define BST_VARIANT_TESTS test_load_corrupted();
+
+#include "../test.c"
+
+/*
+ * Loads the bytes as a file written by bstc_save, prints whether they contain
+ * a tree.
+ */
+void print_load(const char *description, const unsigned char *bytes,
+                size_t length) {
+  bstc_tree_t tree;
+  FILE *file = tmpfile();
+  if (file == NULL || fwrite(bytes, 1, length, file) != length ||
+      fseek(file, 0, SEEK_SET) != 0) {
+    printf("Temporary file failed\n");
+    exit(1);
+  }
+  printf("%s: %s\n", description, bstc_load(&tree, file) ? "tree" : "refused");
+  fclose(file);
+  bstc_dispose(&tree);
+}
+
+TEST(test_load_corrupted, "Refuse corrupted files")
+bstc_init(&test_tree);
+insert_many(&test_tree, base_keys, base_values, base_data_count);
+bstc_delete(&test_tree, 'A');
+
+unsigned char bytes[sizeof(bstc_file_header_t) + 16 * BSTC_RECORD_SIZE];
+FILE *file = tmpfile();
+if (file == NULL || !bstc_save(&test_tree, file) ||
+    fseek(file, 0, SEEK_SET) != 0) {
+  printf("Serialization failed\n");
+  exit(1);
+}
+size_t length = fread(bytes, 1, sizeof(bytes), file);
+fclose(file);
+
+// Left index of the root node (its record is the first one)
+unsigned char *root_left = bytes + sizeof(bstc_file_header_t) + sizeof(int);
+bstc_index_t index;
+print_load("Saved tree", bytes, length);
+print_load("Truncated", bytes, length - 1);
+
+bytes[0] ^= 1;
+print_load("Wrong magic", bytes, length);
+bytes[0] ^= 1;
+
+memcpy(&index, root_left, sizeof(index));
+bstc_index_t outside = test_tree.used;
+memcpy(root_left, &outside, sizeof(outside));
+print_load("Child out of the array", bytes, length);
+
+bstc_index_t cycle = test_tree.root;
+memcpy(root_left, &cycle, sizeof(cycle));
+print_load("Child is its ancestor", bytes, length);
+memcpy(root_left, &index, sizeof(index));
+
+bstc_index_t free_node;
+unsigned char *free_list = bytes + offsetof(bstc_file_header_t, free);
+memcpy(&free_node, free_list, sizeof(free_node));
+memcpy(free_list, &cycle, sizeof(cycle));
+print_load("Free list in the tree", bytes, length);
+memcpy(free_list, &free_node, sizeof(free_node));
+
+print_load("Restored", bytes, length);
+ENDTEST
@@ -0,0 +1,9 @@
+/*
+ * Instances of the generic binary search trees declared in generic.h.
+ */
+
+#include "generic.h"
+
+BSTDEF(int32_t, int, i32, BST_GENERIC_CMP)
+BSTDEF(int64_t, int, i64, BST_GENERIC_CMP)
+BSTDEF(const char *, int, str, BST_GENERIC_STRCMP)
@@ -0,0 +1,194 @@
+/*
+ * Header file for the generic binary search trees.
+ *
+ * Trees are generated by macros for the given key type K and value type V
+ * (in the same way as the stacks of iter/stack.h). bst_node_t holds only char
+ * keys, the generated trees can hold integers, strings or any other keys. Keys
+ * are compared by a macro (or an inline function) given to the definition, so
+ * the comparison is inlined into every step of the search instead of calling
+ * a comparator through a function pointer.
+ *
+ * BSTDEC(K, V, TNAME) declares, for example for TNAME=i32:
+ *   Data type bst_i32_node_t
+ *   Functions void bst_i32_init(bst_i32_node_t **tree)
+ *             void bst_i32_insert(bst_i32_node_t **tree, K key, V value)
+ *             bool bst_i32_search(bst_i32_node_t *tree, K key, V *value)
+ *             void bst_i32_delete(bst_i32_node_t **tree, K key)
+ *             void bst_i32_dispose(bst_i32_node_t **tree)
+ *
+ * BSTDEF(K, V, TNAME, CMP) defines the functions in one translation unit.
+ * CMP(a, b) is negative, zero or positive if a is less than, equal to or
+ * greater than b. The trees are balanced like avl/btree.c, so sorted keys
+ * (for example increasing IDs) don't make them degenerate.
+ */
+
+#ifndef IAL_BTREE_GENERIC_H
+#define IAL_BTREE_GENERIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Comparison of keys comparable by < and >
+#define BST_GENERIC_CMP(A, B) (((A) > (B)) - ((A) < (B)))
+
+// Comparison of string keys
+#define BST_GENERIC_STRCMP(A, B) strcmp((A), (B))
+
+#define BSTDEC(K, V, TNAME)                                                    \
+  typedef struct bst_##TNAME##_node {                                          \
+    K key;                                                                     \
+    V value;                                                                   \
+    struct bst_##TNAME##_node *left;                                           \
+    struct bst_##TNAME##_node *right;                                          \
+    unsigned char height;                                                      \
+  } bst_##TNAME##_node_t;                                                      \
+                                                                               \
+  void bst_##TNAME##_init(bst_##TNAME##_node_t **tree);                        \
+  void bst_##TNAME##_insert(bst_##TNAME##_node_t **tree, K key, V value);      \
+  bool bst_##TNAME##_search(bst_##TNAME##_node_t *tree, K key, V *value);      \
+  void bst_##TNAME##_delete(bst_##TNAME##_node_t **tree, K key);               \
+  void bst_##TNAME##_dispose(bst_##TNAME##_node_t **tree);
+
+#define BSTDEF(K, V, TNAME, CMP)                                               \
+  static inline int bst_##TNAME##_height(bst_##TNAME##_node_t *tree) {         \
+    return tree != NULL ? tree->height : 0;                                    \
+  }                                                                            \
+                                                                               \
+  static inline void bst_##TNAME##_update(bst_##TNAME##_node_t *tree) {        \
+    int left = bst_##TNAME##_height(tree->left);                               \
+    int right = bst_##TNAME##_height(tree->right);                             \
+    tree->height = (unsigned char)((left > right ? left : right) + 1);         \
+  }                                                                            \
+                                                                               \
+  static void bst_##TNAME##_rotate_right(bst_##TNAME##_node_t **tree) {        \
+    bst_##TNAME##_node_t *root = (*tree)->left;                                \
+    (*tree)->left = root->right;                                               \
+    root->right = *tree;                                                       \
+    bst_##TNAME##_update(*tree);                                               \
+    bst_##TNAME##_update(root);                                                \
+    *tree = root;                                                              \
+  }                                                                            \
+                                                                               \
+  static void bst_##TNAME##_rotate_left(bst_##TNAME##_node_t **tree) {         \
+    bst_##TNAME##_node_t *root = (*tree)->right;                               \
+    (*tree)->right = root->left;                                               \
+    root->left = *tree;                                                        \
+    bst_##TNAME##_update(*tree);                                               \
+    bst_##TNAME##_update(root);                                                \
+    *tree = root;                                                              \
+  }                                                                            \
+                                                                               \
+  static void bst_##TNAME##_rebalance(bst_##TNAME##_node_t **tree) {           \
+    bst_##TNAME##_node_t *node = *tree;                                        \
+    int balance =                                                              \
+        bst_##TNAME##_height(node->right) - bst_##TNAME##_height(node->left);  \
+    if (balance < -1) {                                                        \
+      if (bst_##TNAME##_height(node->left->left) <                             \
+          bst_##TNAME##_height(node->left->right)) {                           \
+        bst_##TNAME##_rotate_left(&node->left);                                \
+      }                                                                        \
+      bst_##TNAME##_rotate_right(tree);                                        \
+    } else if (balance > 1) {                                                  \
+      if (bst_##TNAME##_height(node->right->right) <                           \
+          bst_##TNAME##_height(node->right->left)) {                           \
+        bst_##TNAME##_rotate_right(&node->right);                              \
+      }                                                                        \
+      bst_##TNAME##_rotate_left(tree);                                         \
+    } else {                                                                   \
+      bst_##TNAME##_update(node);                                              \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void bst_##TNAME##_init(bst_##TNAME##_node_t **tree) { *tree = NULL; }       \
+                                                                               \
+  bool bst_##TNAME##_search(bst_##TNAME##_node_t *tree, K key, V *value) {     \
+    while (tree != NULL) {                                                     \
+      int cmp = CMP(key, tree->key);                                           \
+      if (cmp < 0) {                                                           \
+        tree = tree->left;                                                     \
+      } else if (cmp > 0) {                                                    \
+        tree = tree->right;                                                    \
+      } else {                                                                 \
+        *value = tree->value;                                                  \
+        return true;                                                           \
+      }                                                                        \
+    }                                                                          \
+    return false;                                                              \
+  }                                                                            \
+                                                                               \
+  void bst_##TNAME##_insert(bst_##TNAME##_node_t **tree, K key, V value) {     \
+    if (*tree == NULL) {                                                       \
+      if ((*tree = malloc(sizeof(bst_##TNAME##_node_t))) == NULL) {            \
+        return;                                                                \
+      }                                                                        \
+      (*tree)->key = key;                                                      \
+      (*tree)->value = value;                                                  \
+      (*tree)->left = NULL;                                                    \
+      (*tree)->right = NULL;                                                   \
+      (*tree)->height = 1;                                                     \
+      return;                                                                  \
+    }                                                                          \
+    int cmp = CMP(key, (*tree)->key);                                          \
+    if (cmp < 0) {                                                             \
+      bst_##TNAME##_insert(&(*tree)->left, key, value);                        \
+    } else if (cmp > 0) {                                                      \
+      bst_##TNAME##_insert(&(*tree)->right, key, value);                       \
+    } else {                                                                   \
+      (*tree)->value = value;                                                  \
+      return;                                                                  \
+    }                                                                          \
+    bst_##TNAME##_rebalance(tree);                                             \
+  }                                                                            \
+                                                                               \
+  static void bst_##TNAME##_replace_by_rightmost(                              \
+      bst_##TNAME##_node_t *target, bst_##TNAME##_node_t **tree) {             \
+    if ((*tree)->right == NULL) {                                              \
+      target->key = (*tree)->key;                                              \
+      target->value = (*tree)->value;                                          \
+      bst_##TNAME##_node_t *left_subtree = (*tree)->left;                      \
+      free(*tree);                                                             \
+      *tree = left_subtree;                                                    \
+      return;                                                                  \
+    }                                                                          \
+    bst_##TNAME##_replace_by_rightmost(target, &(*tree)->right);               \
+    bst_##TNAME##_rebalance(tree);                                             \
+  }                                                                            \
+                                                                               \
+  void bst_##TNAME##_delete(bst_##TNAME##_node_t **tree, K key) {              \
+    if (*tree == NULL) {                                                       \
+      return;                                                                  \
+    }                                                                          \
+    int cmp = CMP(key, (*tree)->key);                                          \
+    if (cmp < 0) {                                                             \
+      bst_##TNAME##_delete(&(*tree)->left, key);                               \
+    } else if (cmp > 0) {                                                      \
+      bst_##TNAME##_delete(&(*tree)->right, key);                              \
+    } else if ((*tree)->left != NULL && (*tree)->right != NULL) {              \
+      bst_##TNAME##_replace_by_rightmost(*tree, &(*tree)->left);               \
+    } else {                                                                   \
+      bst_##TNAME##_node_t *node = *tree;                                      \
+      *tree = node->left != NULL ? node->left : node->right;                   \
+      free(node);                                                              \
+      return;                                                                  \
+    }                                                                          \
+    bst_##TNAME##_rebalance(tree);                                             \
+  }                                                                            \
+                                                                               \
+  void bst_##TNAME##_dispose(bst_##TNAME##_node_t **tree) {                    \
+    if (*tree == NULL) {                                                       \
+      return;                                                                  \
+    }                                                                          \
+    bst_##TNAME##_dispose(&(*tree)->left);                                     \
+    bst_##TNAME##_dispose(&(*tree)->right);                                    \
+    free(*tree);                                                               \
+    *tree = NULL;                                                              \
+  }
+
+// Trees used by the library itself (integer and string keys)
+BSTDEC(int32_t, int, i32)
+BSTDEC(int64_t, int, i64)
+BSTDEC(const char *, int, str)
+
+#endif
@@ -0,0 +1,179 @@
+#include "generic.h"
+#include <stdio.h>
+
+#define GENERATED_COUNT 1000
+
+// Instance for a user-defined key type compared by an inline function
+typedef struct point {
+  int x;
+  int y;
+} point_t;
+
+static inline int compare_points(point_t a, point_t b) {
+  if (a.x != b.x) {
+    return a.x < b.x ? -1 : 1;
+  }
+  return BST_GENERIC_CMP(a.y, b.y);
+}
+
+BSTDEC(point_t, double, point)
+BSTDEF(point_t, double, point, compare_points)
+
+void init_test() {
+  printf("Generic Binary Search Trees - testing script\n");
+  printf("--------------------------------------------\n");
+  printf("\n");
+}
+
+int count_nodes(bst_i32_node_t *tree) {
+  return tree != NULL
+             ? count_nodes(tree->left) + count_nodes(tree->right) + 1
+             : 0;
+}
+
+void print_i32_inorder(bst_i32_node_t *tree) {
+  if (tree != NULL) {
+    print_i32_inorder(tree->left);
+    printf("[%d,%d]", tree->key, tree->value);
+    print_i32_inorder(tree->right);
+  }
+}
+
+void check_i32(bst_i32_node_t *tree, int step) {
+  int found = 0;
+  int missing = 0;
+  int wrong = 0;
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    int value;
+    if (!bst_i32_search(tree, i * 1000003, &value)) {
+      missing++;
+    } else if (i % step != 0 || value != i) {
+      wrong++;
+    } else {
+      found++;
+    }
+  }
+  printf("Found: %d, missing: %d, unexpected: %d\n", found, missing, wrong);
+  printf("Nodes: %d, height: %d\n", count_nodes(tree),
+         tree != NULL ? tree->height : 0);
+}
+
+void test_i32_sorted() {
+  printf("[test_i32_sorted] Insert and update increasing integer keys\n");
+  bst_i32_node_t *tree;
+  bst_i32_init(&tree);
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    bst_i32_insert(&tree, i * 1000003, -i);
+  }
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    bst_i32_insert(&tree, i * 1000003, i);
+  }
+  check_i32(tree, 1);
+  bst_i32_dispose(&tree);
+  check_i32(tree, 1);
+  printf("\n");
+}
+
+void test_i32_delete() {
+  printf("[test_i32_delete] Delete every second integer key\n");
+  bst_i32_node_t *tree;
+  bst_i32_init(&tree);
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    bst_i32_insert(&tree, i * 1000003, i);
+  }
+  for (int i = 1; i < GENERATED_COUNT; i += 2) {
+    bst_i32_delete(&tree, i * 1000003);
+  }
+  bst_i32_delete(&tree, 1);
+  check_i32(tree, 2);
+  bst_i32_dispose(&tree);
+  printf("\n");
+}
+
+void test_i32_negative() {
+  printf("[test_i32_negative] Negative keys are ordered before positive\n");
+  bst_i32_node_t *tree;
+  bst_i32_init(&tree);
+  for (int i = -5; i <= 5; i++) {
+    bst_i32_insert(&tree, i * 7 % 11, i);
+  }
+  print_i32_inorder(tree);
+  printf("\n");
+  bst_i32_dispose(&tree);
+  printf("\n");
+}
+
+void test_i64() {
+  printf("[test_i64] Keys which don't fit into 32 bits\n");
+  bst_i64_node_t *tree;
+  bst_i64_init(&tree);
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    bst_i64_insert(&tree, ((int64_t)i << 32) | 1, i);
+  }
+  int value = -1;
+  bool found = bst_i64_search(tree, ((int64_t)500 << 32) | 1, &value);
+  printf("Search 500 << 32 | 1: %s, value %d\n", found ? "found" : "not found",
+         value);
+  value = -1;
+  found = bst_i64_search(tree, (int64_t)500 << 32, &value);
+  printf("Search 500 << 32: %s, value %d\n", found ? "found" : "not found",
+         value);
+  printf("Height: %d\n", tree->height);
+  bst_i64_dispose(&tree);
+  printf("\n");
+}
+
+void test_str() {
+  printf("[test_str] Insert, search and delete string keys\n");
+  const char *keys[] = {"Bitcoin", "Ethereum", "Cardano",  "Tether",
+                        "Solana",  "Polkadot", "Dogecoin", "Litecoin"};
+  bst_str_node_t *tree;
+  bst_str_init(&tree);
+  for (int i = 0; i < 8; i++) {
+    bst_str_insert(&tree, keys[i], i);
+  }
+  char key[16] = "Solana";
+  int value = -1;
+  bool found = bst_str_search(tree, key, &value);
+  printf("Search %s: %s, value %d\n", key, found ? "found" : "not found",
+         value);
+  bst_str_delete(&tree, "Solana");
+  value = -1;
+  found = bst_str_search(tree, key, &value);
+  printf("Search %s: %s, value %d\n", key, found ? "found" : "not found",
+         value);
+  printf("Root: %s, height: %d\n", tree->key, tree->height);
+  bst_str_dispose(&tree);
+  printf("\n");
+}
+
+void test_struct_key() {
+  printf("[test_struct_key] Keys compared by a user-defined function\n");
+  bst_point_node_t *tree;
+  bst_point_init(&tree);
+  for (int x = -10; x < 10; x++) {
+    for (int y = -10; y < 10; y++) {
+      bst_point_insert(&tree, (point_t){x, y}, x * 100.0 + y);
+    }
+  }
+  double value = 0;
+  bst_point_search(tree, (point_t){-3, 7}, &value);
+  printf("Value of (-3,7): %.1f\n", value);
+  printf("Contains (10,0): %s\n",
+         bst_point_search(tree, (point_t){10, 0}, &value) ? "yes" : "no");
+  printf("Root: (%d,%d), height: %d\n", tree->key.x, tree->key.y,
+         tree->height);
+  bst_point_dispose(&tree);
+  printf("\n");
+}
+
+int main() {
+  init_test();
+
+  test_i32_sorted();
+  test_i32_delete();
+  test_i32_negative();
+  test_i64();
+  test_str();
+  test_struct_key();
+}
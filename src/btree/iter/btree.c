@@ -7,6 +7,7 @@
  */
 
 #include "../btree.h"
+#include "../pool.h"
 #include "stack.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -94,9 +95,10 @@ void bst_insert(bst_node_t **tree, char key, int value) {
     }
 
     // Key isn't in the tree --> add it
-    // Create a new node
+    // Create a new node (from the pool of the tree, or a new pool if the tree
+    // is empty)
     bst_node_t *new_item;
-    if ((new_item = malloc(sizeof(bst_node_t))) == NULL) {
+    if ((new_item = bst_pool_alloc(where)) == NULL) {
         return;
     }
 
@@ -150,7 +152,7 @@ void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
     target->value = rightmost->value;
 
     bst_node_t *left_subtree = rightmost->left;
-    free(rightmost);
+    bst_pool_free(rightmost);
     *ptr_to_rightmost = left_subtree;
 }
 
@@ -196,7 +198,7 @@ void bst_delete(bst_node_t **tree, char key) {
 
     if (deletion_item->left == NULL && deletion_item->right == NULL) {
         // Item has no child --> just delete it
-        free(deletion_item);
+        bst_pool_free(deletion_item);
         *ptr_to_del_item = NULL;
     } else if (deletion_item->left != NULL && deletion_item->right == NULL) {
         // Item has LEFT child only
@@ -205,7 +207,7 @@ void bst_delete(bst_node_t **tree, char key) {
         // Replace this node with the left one
         **ptr_to_del_item = *left_subtree;
 
-        free(left_subtree);
+        bst_pool_free(left_subtree);
     } else if (deletion_item->left == NULL && deletion_item->right != NULL) {
         // Item has RIGHT child only
         bst_node_t *right_subtree = deletion_item->right;
@@ -213,7 +215,7 @@ void bst_delete(bst_node_t **tree, char key) {
         // Replace this node with the right one
         **ptr_to_del_item = *right_subtree;
 
-        free(right_subtree);
+        bst_pool_free(right_subtree);
     } else {
         // Item has BOTH children
         bst_replace_by_rightmost(deletion_item, &(deletion_item->left));
@@ -231,6 +233,12 @@ void bst_delete(bst_node_t **tree, char key) {
  * vlastných pomocných funkcií.
  */
 void bst_dispose(bst_node_t **tree) {
+    if (*tree != NULL && bst_pool_release(*tree)) {
+        // All the nodes are released with the chunks of the pool
+        *tree = NULL;
+        return;
+    }
+
     // Prepare help stack
     stack_bst_t help_stack;
     stack_bst_init(&help_stack);
@@ -250,7 +258,7 @@ void bst_dispose(bst_node_t **tree) {
             bst_node_t *help_item = current_item;
             current_item = current_item->left;
 
-            free(help_item);
+            bst_pool_free(help_item);
         }
     } while (current_item != NULL || !stack_bst_empty(&help_stack));
 
@@ -0,0 +1,188 @@
+/*
+ * Pools of the tree nodes
+ *
+ * The first chunk of the pool holds the pool itself behind the chunk header.
+ * Released nodes are linked by their left pointers. When the last node of the
+ * pool is released (the tree becomes empty), all the chunks are released too.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "pool.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifndef BST_NO_POOL
+
+// Header at the beginning of every chunk
+typedef struct bst_pool_chunk {
+    struct bst_pool *pool;       // pool owning the chunk
+    struct bst_pool_chunk *next; // next chunk of the pool
+} bst_pool_chunk_t;
+
+// Pool of the nodes of one tree
+typedef struct bst_pool {
+    bst_pool_chunk_t *chunks; // chunks, the last one contains the pool itself
+    bst_node_t *free_nodes;   // released nodes linked by their left pointers
+    char *next;               // first unused byte of the newest chunk
+    char *end;                // end of the newest chunk
+    size_t used;              // nodes allocated and not released
+    bst_node_t *root;         // first node of the pool (root of the tree)
+} bst_pool_t;
+
+/*
+ * Returns the pool which the node was allocated from.
+ */
+static inline bst_pool_t *bst_pool_of(bst_node_t *node) {
+    uintptr_t chunk = (uintptr_t) node & ~(uintptr_t) (BST_POOL_CHUNK - 1);
+    return ((bst_pool_chunk_t *) chunk)->pool;
+}
+
+/*
+ * Allocates a new chunk and returns the first address usable for nodes (or for
+ * the pool itself), or NULL if there isn't enough memory.
+ */
+static char *bst_pool_new_chunk(bst_pool_chunk_t **chunk) {
+    void *memory;
+    if (posix_memalign(&memory, BST_POOL_CHUNK, BST_POOL_CHUNK) != 0) {
+        return NULL;
+    }
+
+    *chunk = memory;
+    return (char *) (*chunk + 1);
+}
+
+/*
+ * Sets the rest of the chunk starting at the address as the space for the new
+ * nodes.
+ */
+static void bst_pool_use_chunk(bst_pool_t *pool, bst_pool_chunk_t *chunk, char *start) {
+    // Nodes must be aligned as their pointers
+    size_t alignment = offsetof(struct { char c; bst_node_t node; }, node);
+    uintptr_t address = ((uintptr_t) start + alignment - 1) & ~(uintptr_t) (alignment - 1);
+
+    chunk->pool = pool;
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->next = (char *) address;
+    pool->end = (char *) chunk + BST_POOL_CHUNK;
+}
+
+static bst_pool_t *bst_pool_create() {
+    bst_pool_chunk_t *chunk;
+    char *start;
+    if ((start = bst_pool_new_chunk(&chunk)) == NULL) {
+        return NULL;
+    }
+
+    bst_pool_t *pool = (bst_pool_t *) start;
+    pool->chunks = NULL;
+    pool->free_nodes = NULL;
+    pool->used = 0;
+    pool->root = NULL;
+    bst_pool_use_chunk(pool, chunk, (char *) (pool + 1));
+
+    return pool;
+}
+
+static void bst_pool_destroy(bst_pool_t *pool) {
+    // The pool is stored in the last chunk, so it's not read after it's freed
+    bst_pool_chunk_t *chunk = pool->chunks;
+    while (chunk != NULL) {
+        bst_pool_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+/*
+ * Allocates a node from the pool of the tree containing the neighbour node,
+ * or from a new pool if neighbour is NULL (the node is the root of a new
+ * tree). Returns NULL if there isn't enough memory.
+ */
+bst_node_t *bst_pool_alloc(bst_node_t *neighbour) {
+    bst_pool_t *pool = neighbour != NULL ? bst_pool_of(neighbour) : bst_pool_create();
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    bst_node_t *node = pool->free_nodes;
+    if (node != NULL) {
+        pool->free_nodes = node->left;
+    } else {
+        if (pool->next + sizeof(bst_node_t) > pool->end) {
+            bst_pool_chunk_t *chunk;
+            char *start;
+            if ((start = bst_pool_new_chunk(&chunk)) == NULL) {
+                return NULL;
+            }
+            bst_pool_use_chunk(pool, chunk, start);
+        }
+
+        node = (bst_node_t *) pool->next;
+        pool->next += sizeof(bst_node_t);
+    }
+    pool->used++;
+
+    if (neighbour == NULL) {
+        pool->root = node;
+    }
+
+    return node;
+}
+
+/*
+ * Releases the node back to its pool. The pool is destroyed with its last
+ * node.
+ */
+void bst_pool_free(bst_node_t *node) {
+    bst_pool_t *pool = bst_pool_of(node);
+    if (node == pool->root) {
+        // Trees keep their root nodes, so this is only a safety net
+        pool->root = NULL;
+    }
+    node->left = pool->free_nodes;
+    pool->free_nodes = node;
+
+    if (--pool->used == 0) {
+        bst_pool_destroy(pool);
+    }
+}
+
+/*
+ * Releases all the nodes of the pool if the node is the root of the tree (the
+ * first node allocated from the pool). Returns false if the node is only the
+ * root of a subtree or if the nodes aren't allocated from pools (they must be
+ * freed one by one then).
+ */
+bool bst_pool_release(bst_node_t *node) {
+    bst_pool_t *pool = bst_pool_of(node);
+    if (node != pool->root) {
+        return false;
+    }
+
+    bst_pool_destroy(pool);
+
+    return true;
+}
+
+#else
+
+bst_node_t *bst_pool_alloc(bst_node_t *neighbour) {
+    (void) neighbour;
+    return malloc(sizeof(bst_node_t));
+}
+
+void bst_pool_free(bst_node_t *node) {
+    free(node);
+}
+
+bool bst_pool_release(bst_node_t *node) {
+    (void) node;
+    return false;
+}
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * Header file for the pools of the tree nodes.
+ *
+ * Every tree allocates its nodes from its own pool: chunks of BST_POOL_CHUNK
+ * bytes are cut into nodes and released nodes are linked into a free list for
+ * the following insertions. Chunks are aligned to their size, so the pool is
+ * found from any node of the tree and the functions need no other handle than
+ * the bst_node_t pointers of btree.h. bst_dispose of the whole tree releases
+ * the chunks instead of freeing every node (nodes of a disposed subtree are
+ * released one by one). The root node is recorded in the pool: the delete
+ * functions keep the root node in place while the tree has other nodes.
+ *
+ * With BST_NO_POOL defined, nodes are allocated by malloc one by one (for
+ * comparison in the benchmarks).
+ */
+
+#ifndef IAL_BTREE_POOL_H
+#define IAL_BTREE_POOL_H
+
+#include "btree.h"
+#include <stdbool.h>
+
+// Size and alignment of a chunk of the nodes (power of two)
+#define BST_POOL_CHUNK 4096
+
+bst_node_t *bst_pool_alloc(bst_node_t *neighbour);
+void bst_pool_free(bst_node_t *node);
+bool bst_pool_release(bst_node_t *node);
+
+#endif
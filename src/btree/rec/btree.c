@@ -6,6 +6,7 @@
  */
 
 #include "../btree.h"
+#include "../pool.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -61,8 +62,8 @@ bool bst_search(bst_node_t *tree, char key, int *value) {
  */
 void bst_insert(bst_node_t **tree, char key, int value) {
     if (*tree == NULL) {
-        // Empty tree --> create new tree
-        if ((*tree = malloc(sizeof(bst_node_t))) == NULL) {
+        // Empty tree --> create new tree (with its own pool of nodes)
+        if ((*tree = bst_pool_alloc(NULL)) == NULL) {
             return;
         }
 
@@ -75,16 +76,33 @@ void bst_insert(bst_node_t **tree, char key, int value) {
     }
 
     // Non-empty tree
+    bst_node_t **subtree;
     if (key < (*tree)->key) {
         // Insert before current key
-        bst_insert(&(*tree)->left, key, value);
+        subtree = &(*tree)->left;
     } else if (key > (*tree)->key) {
         // Insert after current key
-        bst_insert(&(*tree)->right, key, value);
+        subtree = &(*tree)->right;
     } else {
         // Keys is already in the tree --> only edit value
         (*tree)->value = value;
+        return;
+    }
+
+    if (*subtree != NULL) {
+        bst_insert(subtree, key, value);
+        return;
+    }
+
+    // Empty subtree --> new leaf from the pool of this tree
+    if ((*subtree = bst_pool_alloc(*tree)) == NULL) {
+        return;
     }
+
+    (*subtree)->key = key;
+    (*subtree)->value = value;
+    (*subtree)->left = NULL;
+    (*subtree)->right = NULL;
 }
 
 /*
@@ -107,7 +125,7 @@ void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
         target->value = (*tree)->value;
 
         bst_node_t *left_subtree = (*tree)->left;
-        free(*tree);
+        bst_pool_free(*tree);
         *tree = left_subtree;
         return;
     }
@@ -150,7 +168,7 @@ void bst_delete(bst_node_t **tree, char key) {
     // We're found subtree with the key
     if ((*tree)->left == NULL && (*tree)->right == NULL) {
         // The node has no child
-        free(*tree);
+        bst_pool_free(*tree);
         (*tree) = NULL;
     } else if ((*tree)->left != NULL && (*tree)->right == NULL) {
         // The node has LEFT child only
@@ -159,7 +177,7 @@ void bst_delete(bst_node_t **tree, char key) {
         // Replace this node with the left one
         (**tree) = *left_subtree;
 
-        free(left_subtree);
+        bst_pool_free(left_subtree);
     } else if ((*tree)->left == NULL && (*tree)->right != NULL) {
         // The node has RIGHT child only
         bst_node_t *right_subtree = (*tree)->right;
@@ -167,7 +185,7 @@ void bst_delete(bst_node_t **tree, char key) {
         // Replace this node with the right one
         (**tree) = *right_subtree;
 
-        free(right_subtree);
+        bst_pool_free(right_subtree);
     } else {
         // The node has BOTH children
         bst_replace_by_rightmost(*tree, &((*tree)->left));
@@ -189,9 +207,15 @@ void bst_dispose(bst_node_t **tree) {
         return;
     }
 
+    if (bst_pool_release(*tree)) {
+        // All the nodes are released with the chunks of the pool
+        (*tree) = NULL;
+        return;
+    }
+
     bst_dispose(&((*tree)->left));
     bst_dispose(&((*tree)->right));
-    free(*tree);
+    bst_pool_free(*tree);
     (*tree) = NULL;
 }
 
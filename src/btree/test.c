@@ -163,6 +163,18 @@ bst_dispose(&test_tree);
 bst_print_tree(test_tree);
 ENDTEST
 
+// Nodes of the compact tree aren't trees by themselves (see compact/test.c)
+#ifndef BST_NO_SUBTREES
+TEST(test_tree_dispose_subtree, "Dispose the left subtree of the root")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_dispose(&test_tree->left);
+bst_print_tree(test_tree);
+bst_insert(&test_tree, 'A', 1);
+bst_print_tree(test_tree);
+ENDTEST
+#endif
+
 TEST(test_tree_preorder, "Traverse the tree using preorder")
 bst_init(&test_tree);
 bst_insert_many(&test_tree, traversal_keys, traversal_values,
@@ -380,6 +392,9 @@ int main(int argc, char *argv[]) {
   test_tree_delete_missing();
   test_tree_delete_root();
   test_tree_dispose_filled();
+#ifndef BST_NO_SUBTREES
+  test_tree_dispose_subtree();
+#endif
   test_tree_preorder();
   test_tree_inorder();
   test_tree_postorder();
@@ -400,4 +415,9 @@ int main(int argc, char *argv[]) {
   test_delete9();
   test_delete9a();
   test_delete10();
+
+#ifdef BST_VARIANT_TESTS
+  // Scenarios of the variant itself (see compact/test.c)
+  BST_VARIANT_TESTS
+#endif
 }
@@ -0,0 +1,45 @@
+#include "test_util_print.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char *subtree_prefix = "  |";
+const char *space_prefix = "   ";
+
+char *make_prefix(const char *prefix, const char *suffix) {
+  char *result = (char *)malloc(strlen(prefix) + strlen(suffix) + 1);
+  strcpy(result, prefix);
+  result = strcat(result, suffix);
+  return result;
+}
+
+void print_subtree(const tree_printer_t *printer, const void *node,
+                   const char *prefix, direction_t from) {
+  if (node != NULL) {
+    char *current_subtree_prefix = make_prefix(prefix, subtree_prefix);
+    char *current_space_prefix = make_prefix(prefix, space_prefix);
+
+    if (from == left) {
+      printf("%s\n", current_subtree_prefix);
+    }
+
+    print_subtree(printer, printer->child(printer->tree, node, right),
+                  from == left ? current_subtree_prefix : current_space_prefix,
+                  right);
+
+    printf("%s  +-", prefix);
+    printer->print_node(printer->tree, node);
+    printf("\n");
+
+    print_subtree(printer, printer->child(printer->tree, node, left),
+                  from == right ? current_subtree_prefix : current_space_prefix,
+                  left);
+
+    if (from == right) {
+      printf("%s\n", current_subtree_prefix);
+    }
+
+    free(current_space_prefix);
+    free(current_subtree_prefix);
+  }
+}
@@ -0,0 +1,17 @@
+#ifndef IAL_BTREE_TEST_UTIL_PRINT_H
+#define IAL_BTREE_TEST_UTIL_PRINT_H
+
+typedef enum direction { left, right, none } direction_t;
+
+// Access to the nodes of a printed tree (pointers, indices, ...)
+typedef struct tree_printer {
+  const void *tree; // passed to the callbacks
+  // Child of the node on the side (left or right), NULL if there is none
+  const void *(*child)(const void *tree, const void *node, direction_t side);
+  void (*print_node)(const void *tree, const void *node);
+} tree_printer_t;
+
+void print_subtree(const tree_printer_t *printer, const void *node,
+                   const char *prefix, direction_t from);
+
+#endif
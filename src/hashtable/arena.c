@@ -0,0 +1,160 @@
+/*
+ * String arena
+ *
+ * Copies are bump-allocated from the newest chunk. When it has not enough
+ * space, a new chunk is allocated and the rest of the old one stays unused.
+ *
+ * Every copy in a chunk takes a multiple of HT_ARENA_GRANULE bytes. Released
+ * copy is linked into the free list of its size (the link is stored in the
+ * copy itself) and the next string of the same size takes it instead of new
+ * space of the chunk.
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Returns the free list for copies of the string of the given length.
+ */
+static inline size_t arena_class(size_t length) {
+    return (length + HT_ARENA_GRANULE) / HT_ARENA_GRANULE - 1;
+}
+
+/*
+ * Initialization of the arena — no memory is allocated until the first string
+ * is copied.
+ */
+void ht_arena_init(ht_arena_t *arena) {
+    arena->chunks = NULL;
+    arena->long_strings = NULL;
+    memset(arena->released, 0, sizeof(arena->released));
+    arena->bytes = 0;
+}
+
+/*
+ * Allocates a separate block for the long string.
+ */
+static char *arena_alloc_long(ht_arena_t *arena, size_t length) {
+    ht_arena_long_t *block;
+    if ((block = malloc(sizeof(ht_arena_long_t) + length + 1)) == NULL) {
+        return NULL;
+    }
+
+    block->prev = NULL;
+    block->next = arena->long_strings;
+    if (block->next != NULL) {
+        block->next->prev = block;
+    }
+    arena->long_strings = block;
+
+    return block->data;
+}
+
+/*
+ * Takes space for a copy of the given size (a multiple of HT_ARENA_GRANULE)
+ * from the newest chunk, or from a new one.
+ */
+static char *arena_alloc_copy(ht_arena_t *arena, size_t size) {
+    ht_arena_chunk_t *chunk = arena->chunks;
+    if (chunk == NULL || chunk->capacity - chunk->used < size) {
+        size_t capacity = chunk == NULL ? HT_ARENA_MIN_CHUNK : chunk->capacity * 2;
+        if (capacity > HT_ARENA_MAX_CHUNK) {
+            capacity = HT_ARENA_MAX_CHUNK;
+        }
+
+        if ((chunk = malloc(sizeof(ht_arena_chunk_t) + capacity)) == NULL) {
+            return NULL;
+        }
+
+        chunk->next = arena->chunks;
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        arena->chunks = chunk;
+    }
+
+    char *copy = chunk->data + chunk->used;
+    chunk->used += size;
+
+    return copy;
+}
+
+/*
+ * Copies the string of the given length (without the terminating null byte)
+ * into the arena. Returns the copy or NULL if there is not enough memory.
+ * The copy is valid until it's freed or the arena is released.
+ */
+char *ht_arena_strdup(ht_arena_t *arena, const char *string, size_t length) {
+    char *copy;
+    if (length + 1 > HT_ARENA_MAX_COPY) {
+        copy = arena_alloc_long(arena, length);
+    } else {
+        size_t class = arena_class(length);
+        if ((copy = arena->released[class]) != NULL) {
+            // Reuse a released copy of the same size
+            memcpy(&arena->released[class], copy, sizeof(char *));
+        } else {
+            copy = arena_alloc_copy(arena, (class + 1) * HT_ARENA_GRANULE);
+        }
+    }
+
+    if (copy == NULL) {
+        return NULL;
+    }
+
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+    arena->bytes += length + 1;
+
+    return copy;
+}
+
+/*
+ * Releases the copy of a string of the given length, its space is reused by
+ * the following copies.
+ */
+void ht_arena_free(ht_arena_t *arena, char *copy, size_t length) {
+    arena->bytes -= length + 1;
+
+    if (length + 1 > HT_ARENA_MAX_COPY) {
+        ht_arena_long_t *block = (ht_arena_long_t *) (copy - offsetof(ht_arena_long_t, data));
+        if (block->prev != NULL) {
+            block->prev->next = block->next;
+        } else {
+            arena->long_strings = block->next;
+        }
+        if (block->next != NULL) {
+            block->next->prev = block->prev;
+        }
+
+        free(block);
+        return;
+    }
+
+    // Copy takes at least HT_ARENA_GRANULE bytes, so the link fits into it
+    size_t class = arena_class(length);
+    memcpy(copy, &arena->released[class], sizeof(char *));
+    arena->released[class] = copy;
+}
+
+/*
+ * Releases all the chunks (and so all the copied strings).
+ * The arena is in the same state as after the initialization.
+ */
+void ht_arena_release(ht_arena_t *arena) {
+    ht_arena_chunk_t *chunk = arena->chunks;
+    while (chunk != NULL) {
+        ht_arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    ht_arena_long_t *block = arena->long_strings;
+    while (block != NULL) {
+        ht_arena_long_t *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    ht_arena_init(arena);
+}
@@ -0,0 +1,59 @@
+/*
+ * Header file for the string arena used by tables owning their keys.
+ *
+ * Strings are copied one after another into big chunks of memory. Released
+ * copies are kept in free lists by their rounded sizes and reused for the
+ * following strings of the same size, so the arena doesn't grow when strings
+ * are repeatedly released and copied. Very long strings are allocated
+ * separately and freed directly. The whole arena is released at once.
+ */
+
+#ifndef IAL_HASHTABLE_ARENA_H
+#define IAL_HASHTABLE_ARENA_H
+
+#include <stddef.h>
+
+// Size of the first chunk in bytes (next chunks are twice bigger)
+#define HT_ARENA_MIN_CHUNK 4096
+
+// Maximum size of a chunk in bytes
+#define HT_ARENA_MAX_CHUNK (1024 * 1024)
+
+// Copies in chunks take multiples of this number of bytes
+#define HT_ARENA_GRANULE 16
+
+// Maximum size of a copy in a chunk (longer strings are allocated separately)
+#define HT_ARENA_MAX_COPY 512
+
+// Number of the free lists (one for every size of a copy in a chunk)
+#define HT_ARENA_CLASSES (HT_ARENA_MAX_COPY / HT_ARENA_GRANULE)
+
+// Chunk of memory for strings
+typedef struct ht_arena_chunk {
+  struct ht_arena_chunk *next; // previously allocated chunk
+  size_t capacity;             // number of bytes in the chunk
+  size_t used;                 // number of bytes already used
+  char data[];                 // strings
+} ht_arena_chunk_t;
+
+// Separately allocated long string
+typedef struct ht_arena_long {
+  struct ht_arena_long *prev; // previous long string, NULL for the first one
+  struct ht_arena_long *next; // next long string, NULL for the last one
+  char data[];                // string
+} ht_arena_long_t;
+
+// String arena
+typedef struct ht_arena {
+  ht_arena_chunk_t *chunks;         // newest chunk (others are linked from it)
+  ht_arena_long_t *long_strings;    // separately allocated long strings
+  char *released[HT_ARENA_CLASSES]; // released copies by their sizes
+  size_t bytes;                     // number of bytes used by strings
+} ht_arena_t;
+
+void ht_arena_init(ht_arena_t *arena);
+char *ht_arena_strdup(ht_arena_t *arena, const char *string, size_t length);
+void ht_arena_free(ht_arena_t *arena, char *copy, size_t length);
+void ht_arena_release(ht_arena_t *arena);
+
+#endif
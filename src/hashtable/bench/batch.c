@@ -0,0 +1,68 @@
+/*
+ * Benchmark of batched lookups (ht_dyn_get_many) against a loop of ht_dyn_get.
+ */
+#include "../dyn_table.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BATCH 256
+#define LOOKUPS 4000000
+
+volatile float sink;
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000, 4000000};
+
+  printf("Batched lookups: loop of ht_dyn_get vs ht_dyn_get_many (%d keys per "
+         "call)\n",
+         BATCH);
+  printf("Average time per lookup in nanoseconds\n\n");
+  printf("%10s %12s %12s %8s\n", "items", "ht_dyn_get", "get_many", "speedup");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+
+    // Lookups use other copies of the keys (as keys from requests would)
+    char **lookups = bench_keys(count, "", 1);
+    bench_shuffle(lookups, count, 2);
+
+    ht_dyn_table_t table;
+    ht_dyn_init(&table);
+    for (size_t i = 0; i < count; i++) {
+      ht_dyn_insert(&table, keys[i], (float)i);
+    }
+
+    float *values[BATCH];
+    size_t rounds = LOOKUPS / BATCH;
+    float sum = 0;
+
+    double start = bench_now();
+    for (size_t r = 0; r < rounds; r++) {
+      char **batch = lookups + (r * BATCH) % (count - BATCH + 1);
+      for (size_t i = 0; i < BATCH; i++) {
+        values[i] = ht_dyn_get(&table, batch[i]);
+      }
+      sum += *values[r % BATCH];
+    }
+    double single = (bench_now() - start) * 1e9 / (double)(rounds * BATCH);
+
+    start = bench_now();
+    for (size_t r = 0; r < rounds; r++) {
+      char **batch = lookups + (r * BATCH) % (count - BATCH + 1);
+      ht_dyn_get_many(&table, batch, BATCH, values);
+      sum += *values[r % BATCH];
+    }
+    double many = (bench_now() - start) * 1e9 / (double)(rounds * BATCH);
+    sink = sum;
+
+    printf("%10zu %12.1f %12.1f %7.2fx\n", count, single, many, single / many);
+
+    ht_dyn_delete_all(&table);
+    bench_free_keys(keys, count);
+    bench_free_keys(lookups, count);
+  }
+
+  return 0;
+}
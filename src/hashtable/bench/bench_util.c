@@ -0,0 +1,59 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+uint64_t bench_random(uint64_t *state) {
+  // splitmix64
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+double bench_now() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+char **bench_keys(size_t count, const char *prefix, uint64_t seed) {
+  static const char alphabet[] =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+  char **keys = malloc(count * sizeof(char *));
+  for (size_t i = 0; i < count; i++) {
+    // Random part of variable length, index at the end keeps keys unique
+    char random_part[24];
+    int length = 4 + (int)(bench_random(&seed) % 16);
+    for (int j = 0; j < length; j++) {
+      random_part[j] = alphabet[bench_random(&seed) % (sizeof(alphabet) - 1)];
+    }
+    random_part[length] = '\0';
+
+    keys[i] = malloc(64);
+    snprintf(keys[i], 64, "%s%s-%zx", prefix, random_part, i);
+  }
+
+  return keys;
+}
+
+void bench_free_keys(char **keys, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    free(keys[i]);
+  }
+  free(keys);
+}
+
+void bench_shuffle(char **keys, size_t count, uint64_t seed) {
+  for (size_t i = count; i > 1; i--) {
+    size_t j = (size_t)(bench_random(&seed) % i);
+    char *tmp = keys[i - 1];
+    keys[i - 1] = keys[j];
+    keys[j] = tmp;
+  }
+}
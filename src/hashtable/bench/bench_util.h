@@ -0,0 +1,14 @@
+#ifndef IAL_HASHTABLE_BENCH_UTIL_H
+#define IAL_HASHTABLE_BENCH_UTIL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+uint64_t bench_random(uint64_t *state);
+double bench_now();
+
+char **bench_keys(size_t count, const char *prefix, uint64_t seed);
+void bench_free_keys(char **keys, size_t count);
+void bench_shuffle(char **keys, size_t count, uint64_t seed);
+
+#endif
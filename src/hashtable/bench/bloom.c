@@ -0,0 +1,80 @@
+/*
+ * Benchmark of lookups with a varying ratio of missing keys: dynamic table
+ * without and with the Bloom filter (HT_DYN_BLOOM).
+ */
+#include "../dyn_table.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LOOKUPS 4000000
+
+volatile size_t sink;
+
+double lookups(ht_dyn_table_t *table, char **keys, size_t count) {
+  size_t found = 0;
+  double start = bench_now();
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    found += ht_dyn_get(table, keys[i % count]) != NULL;
+  }
+  sink = found;
+
+  return (bench_now() - start) * 1e9 / LOOKUPS;
+}
+
+int main() {
+  const size_t sizes[] = {10000, 1000000, 4000000};
+  const int miss_ratios[] = {0, 25, 50, 75, 90, 99};
+
+  printf("Lookups with missing keys: ht_dyn_get without and with the Bloom "
+         "filter\n");
+  printf("Nanoseconds per lookup\n\n");
+  printf("%10s %6s %10s %10s %8s\n", "items", "misses", "plain", "bloom",
+         "speedup");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+    char **present = bench_keys(count, "", 1);
+    char **missing = bench_keys(count, "missing-", 2);
+
+    ht_dyn_table_t plain;
+    ht_dyn_table_t filtered;
+    ht_dyn_init(&plain);
+    ht_dyn_init_with(&filtered, HT_DYN_BLOOM);
+    for (size_t i = 0; i < count; i++) {
+      ht_dyn_insert(&plain, keys[i], (float)i);
+      ht_dyn_insert(&filtered, keys[i], (float)i);
+    }
+
+    // Lookups randomly mix copies of the stored keys with missing keys; they
+    // aren't shuffled, so reading the looked up strings costs little and the
+    // times are mostly the work of the tables
+    char **mixed = malloc(count * sizeof(char *));
+    if (mixed == NULL) {
+      return 1;
+    }
+    for (size_t r = 0; r < sizeof(miss_ratios) / sizeof(miss_ratios[0]);
+         r++) {
+      uint64_t state = 3;
+      for (size_t i = 0; i < count; i++) {
+        int miss = (int)(bench_random(&state) % 100) < miss_ratios[r];
+        mixed[i] = miss ? missing[i] : present[i];
+      }
+
+      double without = lookups(&plain, mixed, count);
+      double with = lookups(&filtered, mixed, count);
+      printf("%10zu %5d%% %10.1f %10.1f %7.2fx\n", count, miss_ratios[r],
+             without, with, without / with);
+    }
+
+    free(mixed);
+    ht_dyn_delete_all(&plain);
+    ht_dyn_delete_all(&filtered);
+    bench_free_keys(keys, count);
+    bench_free_keys(present, count);
+    bench_free_keys(missing, count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Benchmark of loading many items into an empty table: loop of ht_dyn_insert
+ * against ht_dyn_insert_bulk.
+ */
+#include "../dyn_table.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Loads of the smaller tables are repeated to get measurable times
+#define MIN_ITEMS 4000000
+
+double load(ht_item_t *items, size_t count, unsigned flags, int bulk) {
+  size_t rounds = count < MIN_ITEMS ? MIN_ITEMS / count : 1;
+  double total = 0;
+
+  for (size_t r = 0; r < rounds; r++) {
+    ht_dyn_table_t table;
+    ht_dyn_init_with(&table, flags);
+
+    double start = bench_now();
+    if (bulk) {
+      ht_dyn_insert_bulk(&table, items, count);
+    } else {
+      for (size_t i = 0; i < count; i++) {
+        ht_dyn_insert(&table, items[i].key, items[i].value);
+      }
+    }
+    total += bench_now() - start;
+
+    ht_dyn_delete_all(&table);
+  }
+
+  return total * 1e9 / (double)(rounds * count);
+}
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000, 4000000};
+  const unsigned flags[] = {0, HT_DYN_SLAB};
+
+  printf("Loading an empty table: loop of ht_dyn_insert vs "
+         "ht_dyn_insert_bulk\n");
+  printf("Average time per item in nanoseconds\n\n");
+  printf("%10s %6s %12s %12s %8s\n", "items", "slab", "insert", "bulk",
+         "speedup");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+    ht_item_t *items = malloc(count * sizeof(ht_item_t));
+    if (items == NULL) {
+      return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+      items[i].key = keys[i];
+      items[i].value = (float)i;
+    }
+
+    for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+      double single = load(items, count, flags[f], 0);
+      double bulk = load(items, count, flags[f], 1);
+      printf("%10zu %6s %12.1f %12.1f %7.2fx\n", count,
+             flags[f] & HT_DYN_SLAB ? "yes" : "no", single, bulk,
+             single / bulk);
+    }
+
+    free(items);
+    bench_free_keys(keys, count);
+  }
+
+  return 0;
+}
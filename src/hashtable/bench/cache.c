@@ -0,0 +1,167 @@
+/*
+ * Trace replay of the bounded cache: every access is a lookup and a miss is
+ * followed by an insertion (as if the value was loaded from the storage).
+ * Hit rate and throughput are measured for both eviction policies.
+ *
+ * Synthetic traces are used by default; a file with one key per line can be
+ * given as the only argument to replay a real trace instead.
+ */
+#include "../cache.h"
+#include "../dyn_table.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KEYS 1000000
+#define ACCESSES 4000000
+
+// Returns index of a key: 80 % of the accesses go to the first fifth of the
+// keys, 80 % of those to the first fifth of the fifth, and so on
+size_t skewed_key(uint64_t *state) {
+  size_t range = KEYS;
+  while (range >= 5 && bench_random(state) % 10 < 8) {
+    range /= 5;
+  }
+  return (size_t)(bench_random(state) % range);
+}
+
+// Skewed accesses only
+void trace_skewed(char **keys, char **trace, size_t capacity) {
+  (void)capacity;
+  uint64_t state = 1;
+  for (size_t i = 0; i < ACCESSES; i++) {
+    trace[i] = keys[skewed_key(&state)];
+  }
+}
+
+// Skewed accesses, every fifth access is a part of a scan over all the keys
+void trace_scan(char **keys, char **trace, size_t capacity) {
+  (void)capacity;
+  uint64_t state = 2;
+  size_t scan = 0;
+  for (size_t i = 0; i < ACCESSES; i++) {
+    if (i % 5 == 0) {
+      trace[i] = keys[scan];
+      scan = scan + 1 == KEYS ? 0 : scan + 1;
+    } else {
+      trace[i] = keys[skewed_key(&state)];
+    }
+  }
+}
+
+// Cyclic accesses to a bit more keys than the capacity
+void trace_loop(char **keys, char **trace, size_t capacity) {
+  size_t length = capacity + capacity / 10;
+  for (size_t i = 0; i < ACCESSES; i++) {
+    trace[i] = keys[i % length];
+  }
+}
+
+void replay(const char *name, char **trace, size_t accesses,
+            size_t capacity) {
+  const ht_cache_policy_t policies[] = {HT_CACHE_CLOCK, HT_CACHE_LRU};
+  const char *policy_names[] = {"CLOCK", "LRU"};
+
+  for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+    ht_cache_t cache;
+    if (!ht_cache_init(&cache, capacity, policies[p])) {
+      exit(1);
+    }
+
+    double start = bench_now();
+    for (size_t i = 0; i < accesses; i++) {
+      if (ht_cache_get(&cache, trace[i]) == NULL) {
+        ht_cache_insert(&cache, trace[i], (float)i);
+      }
+    }
+    double seconds = bench_now() - start;
+
+    printf("%8s %10zu %8s %9.2f%% %10.2f %10zu\n", name, capacity,
+           policy_names[p],
+           100.0 * (double)cache.counters.hits / (double)accesses,
+           (double)accesses / seconds / 1e6, cache.counters.evictions);
+
+    ht_cache_destroy(&cache);
+  }
+}
+
+void print_header() {
+  printf("%8s %10s %8s %10s %10s %10s\n", "trace", "capacity", "policy",
+         "hit rate", "Mops/s", "evictions");
+}
+
+int replay_file(const char *path) {
+  FILE *file;
+  if ((file = fopen(path, "r")) == NULL) {
+    perror(path);
+    return 1;
+  }
+
+  // Equal keys of the trace share one string, so the cache stores no copies
+  ht_dyn_table_t distinct;
+  ht_dyn_init_with(&distinct, HT_DYN_OWN_KEYS);
+  size_t accesses = 0;
+  size_t allocated = 1024;
+  char **trace = malloc(allocated * sizeof(char *));
+  char line[256];
+  while (trace != NULL && fgets(line, sizeof(line), file) != NULL) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if (accesses == allocated) {
+      allocated *= 2;
+      trace = realloc(trace, allocated * sizeof(char *));
+    }
+    if (trace != NULL) {
+      trace[accesses++] = ht_dyn_intern(&distinct, line);
+    }
+  }
+  fclose(file);
+  if (trace == NULL) {
+    return 1;
+  }
+
+  printf("Trace %s: %zu accesses, %zu distinct keys\n\n", path, accesses,
+         distinct.count);
+  print_header();
+  const size_t percents[] = {1, 10, 50};
+  for (size_t c = 0; c < sizeof(percents) / sizeof(percents[0]); c++) {
+    size_t capacity = distinct.count * percents[c] / 100;
+    replay("file", trace, accesses, capacity != 0 ? capacity : 1);
+  }
+
+  free(trace);
+  ht_dyn_delete_all(&distinct);
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1) {
+    return replay_file(argv[1]);
+  }
+
+  void (*traces[])(char **, char **, size_t) = {trace_skewed, trace_scan,
+                                                trace_loop};
+  const char *names[] = {"skewed", "scan", "loop"};
+  const size_t capacities[] = {KEYS / 100, KEYS / 10};
+
+  char **keys = bench_keys(KEYS, "", 1);
+  char **trace = malloc(ACCESSES * sizeof(char *));
+  if (trace == NULL) {
+    return 1;
+  }
+
+  printf("Bounded cache: %d keys, %d accesses per trace\n\n", KEYS, ACCESSES);
+  print_header();
+  for (size_t t = 0; t < sizeof(traces) / sizeof(traces[0]); t++) {
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+      traces[t](keys, trace, capacities[c]);
+      replay(names[t], trace, ACCESSES, capacities[c]);
+    }
+  }
+
+  free(trace);
+  bench_free_keys(keys, KEYS);
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Collision-heavy benchmark of lists of synonyms compared by stored hashes.
+ *
+ * Many keys with a long common prefix are inserted into the fixed size table
+ * with MAX_HT_SIZE buckets, so the lists of synonyms are long. Number of
+ * strcmp calls made by ht_search is compared with the number of calls made by
+ * the original search (strcmp for every visited item), which is reimplemented
+ * here. strcmp is counted by linker wrapping (-Wl,--wrap=strcmp).
+ */
+#include "../hashtable.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KEY_COUNT 20000
+#define ROUNDS 5
+
+volatile size_t sink;
+size_t strcmp_calls = 0;
+
+int __real_strcmp(const char *s1, const char *s2);
+
+int __wrap_strcmp(const char *s1, const char *s2) {
+  strcmp_calls++;
+  return __real_strcmp(s1, s2);
+}
+
+/*
+ * Search as it was implemented before the items remembered their hashes.
+ */
+ht_item_t *search_without_hashes(ht_table_t *table, char *key) {
+  ht_item_t *found = (*table)[get_hash(key)];
+  while (found != NULL && strcmp(found->key, key) != 0) {
+    found = found->next;
+  }
+
+  return found;
+}
+
+void run(const char *name, ht_table_t *table, char **keys, size_t count) {
+  ht_item_t *(*searches[])(ht_table_t *, char *) = {search_without_hashes,
+                                                     ht_search};
+  const char *labels[] = {"strcmp only", "hash first"};
+
+  for (int s = 0; s < 2; s++) {
+    size_t found = 0;
+    strcmp_calls = 0;
+    double start = bench_now();
+    for (int r = 0; r < ROUNDS; r++) {
+      for (size_t i = 0; i < count; i++) {
+        found += searches[s](table, keys[i]) != NULL;
+      }
+    }
+    double ns = (bench_now() - start) * 1e9 / (double)(ROUNDS * count);
+    sink = found;
+
+    printf("%-8s %-12s %14.2f %12.1f\n", name, labels[s],
+           (double)strcmp_calls / (double)(ROUNDS * count), ns);
+  }
+}
+
+int main() {
+  HT_SIZE = MAX_HT_SIZE;
+
+  char **keys = malloc(KEY_COUNT * sizeof(char *));
+  char **missing = malloc(KEY_COUNT * sizeof(char *));
+  for (size_t i = 0; i < KEY_COUNT; i++) {
+    keys[i] = malloc(64);
+    missing[i] = malloc(64);
+    snprintf(keys[i], 64, "https://example.com/api/v1/users/%zu/profile", i);
+    snprintf(missing[i], 64, "https://example.com/api/v1/users/%zu/settings",
+             i);
+  }
+
+  ht_table_t *table = malloc(sizeof(ht_table_t));
+  ht_init(table);
+  for (size_t i = 0; i < KEY_COUNT; i++) {
+    ht_insert(table, keys[i], (float)i);
+  }
+  bench_shuffle(keys, KEY_COUNT, 1);
+
+  printf("Collision-heavy lookups: %d keys in %d buckets (%.1f items per "
+         "bucket)\n\n",
+         KEY_COUNT, HT_SIZE, (double)KEY_COUNT / HT_SIZE);
+  printf("%-8s %-12s %14s %12s\n", "lookups", "compare", "strcmp/lookup",
+         "ns/lookup");
+  run("hit", table, keys, KEY_COUNT);
+  run("miss", table, missing, KEY_COUNT);
+
+  ht_delete_all(table);
+  free(table);
+  bench_free_keys(keys, KEY_COUNT);
+  bench_free_keys(missing, KEY_COUNT);
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Throughput of the thread-safe table with one shard (a single lock for the
+ * whole table) and with many shards, for 1 to 64 threads.
+ *
+ * Every thread performs its share of the operations: 90 % lookups of random
+ * existing keys and 10 % insertions (updates) of random keys.
+ */
+#include "../conc_table.h"
+#include "bench_util.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ITEMS 100000
+#define OPERATIONS 4000000
+#define WRITE_PERCENT 10
+#define SHARDS 64
+
+// Work of one thread
+typedef struct worker {
+  ht_conc_table_t *table;
+  char **keys;
+  size_t operations;
+  uint64_t seed;
+  size_t found;
+} worker_t;
+
+void *run_worker(void *arg) {
+  worker_t *worker = arg;
+  uint64_t state = worker->seed;
+  float value;
+  worker->found = 0;
+  for (size_t i = 0; i < worker->operations; i++) {
+    uint64_t random = bench_random(&state);
+    char *key = worker->keys[random % ITEMS];
+    if ((random >> 32) % 100 < WRITE_PERCENT) {
+      ht_conc_insert(worker->table, key, (float)i);
+    } else {
+      worker->found += ht_conc_get(worker->table, key, &value);
+    }
+  }
+  return NULL;
+}
+
+// Returns millions of operations per second
+double measure(size_t shards, size_t thread_count, char **keys) {
+  ht_conc_table_t table;
+  if (!ht_conc_init(&table, shards)) {
+    return 0;
+  }
+  for (size_t i = 0; i < ITEMS; i++) {
+    ht_conc_insert(&table, keys[i], (float)i);
+  }
+
+  pthread_t threads[64];
+  worker_t workers[64];
+  double start = bench_now();
+  for (size_t t = 0; t < thread_count; t++) {
+    workers[t] = (worker_t){&table, keys, OPERATIONS / thread_count, t + 1, 0};
+    pthread_create(&threads[t], NULL, run_worker, &workers[t]);
+  }
+  for (size_t t = 0; t < thread_count; t++) {
+    pthread_join(threads[t], NULL);
+  }
+  double elapsed = bench_now() - start;
+
+  ht_conc_destroy(&table);
+
+  return (double)(OPERATIONS / thread_count * thread_count) / elapsed / 1e6;
+}
+
+int main() {
+  const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+  printf("Concurrent table: %d items, %d %% writes, %d operations per run\n",
+         ITEMS, WRITE_PERCENT, OPERATIONS);
+  printf("Throughput in millions of operations per second\n\n");
+  printf("%8s %12s %12s %8s\n", "threads", "1 shard", "64 shards", "speedup");
+
+  char **keys = bench_keys(ITEMS, "", 1);
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]);
+       i++) {
+    double single = measure(1, thread_counts[i], keys);
+    double sharded = measure(SHARDS, thread_counts[i], keys);
+    printf("%8zu %12.2f %12.2f %7.2fx\n", thread_counts[i], single, sharded,
+           sharded / single);
+  }
+  bench_free_keys(keys, ITEMS);
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Latency of single lookups in the chained table (ht_dyn_table_t) and in the
+ * bucketized cuckoo table (ht_cuckoo_table_t) with the same keys. Every lookup
+ * is timed separately, so the times include the overhead of reading the clock
+ * (the same for both tables).
+ */
+#include "../cuckoo.h"
+#include "../dyn_table.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LOOKUPS 1000000
+
+volatile float sink;
+
+int compare_doubles(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+void print_percentiles(size_t count, const char *name, const char *lookups,
+                       double *times) {
+  qsort(times, LOOKUPS, sizeof(double), compare_doubles);
+  printf("%10zu %8s %6s %8.0f %8.0f %8.0f %8.0f\n", count, name, lookups,
+         times[LOOKUPS / 2], times[LOOKUPS / 100 * 99],
+         times[LOOKUPS / 1000 * 999], times[LOOKUPS - 1]);
+}
+
+void bench_dyn(ht_dyn_table_t *table, char **keys, size_t count,
+               double *times) {
+  float sum = 0;
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    double start = bench_now();
+    float *value = ht_dyn_get(table, keys[i % count]);
+    times[i] = (bench_now() - start) * 1e9;
+    sum += value != NULL ? *value : 1;
+  }
+  sink = sum;
+}
+
+void bench_cuckoo(ht_cuckoo_table_t *table, char **keys, size_t count,
+                  double *times) {
+  float sum = 0;
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    double start = bench_now();
+    float *value = ht_cuckoo_get(table, keys[i % count]);
+    times[i] = (bench_now() - start) * 1e9;
+    sum += value != NULL ? *value : 1;
+  }
+  sink = sum;
+}
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000};
+
+  double *times = malloc(LOOKUPS * sizeof(double));
+  if (times == NULL) {
+    return 1;
+  }
+
+  printf("Latency of single lookups in nanoseconds (including the clock)\n\n");
+  printf("%10s %8s %6s %8s %8s %8s %8s\n", "items", "table", "keys", "p50",
+         "p99", "p999", "max");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+    char **hits = bench_keys(count, "", 1);
+    char **misses = bench_keys(count, "missing-", 2);
+    bench_shuffle(hits, count, 3);
+
+    ht_dyn_table_t dyn;
+    ht_cuckoo_table_t cuckoo;
+    ht_dyn_init(&dyn);
+    ht_cuckoo_init(&cuckoo);
+    for (size_t i = 0; i < count; i++) {
+      ht_dyn_insert(&dyn, keys[i], (float)i);
+      ht_cuckoo_insert(&cuckoo, keys[i], (float)i);
+    }
+
+    bench_dyn(&dyn, hits, count, times);
+    print_percentiles(count, "chained", "hit", times);
+    bench_cuckoo(&cuckoo, hits, count, times);
+    print_percentiles(count, "cuckoo", "hit", times);
+    bench_dyn(&dyn, misses, count, times);
+    print_percentiles(count, "chained", "miss", times);
+    bench_cuckoo(&cuckoo, misses, count, times);
+    print_percentiles(count, "cuckoo", "miss", times);
+
+    ht_dyn_delete_all(&dyn);
+    ht_cuckoo_delete_all(&cuckoo);
+    bench_free_keys(keys, count);
+    bench_free_keys(hits, count);
+    bench_free_keys(misses, count);
+  }
+
+  free(times);
+
+  return 0;
+}
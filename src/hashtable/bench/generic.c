@@ -0,0 +1,83 @@
+/*
+ * Benchmark of integer keys: generic table specialized for uint64_t keys
+ * against ht_dyn_table_t with the integers formatted as strings.
+ */
+#include "../dyn_table.h"
+#include "../generic.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LOOKUPS 4000000
+
+volatile float sink;
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000};
+
+  printf("Integer keys: ht_dyn (keys as strings) vs ht_u64 (generic table)\n");
+  printf("Average time per operation in nanoseconds\n\n");
+  printf("%10s %12s %12s %12s %12s\n", "items", "dyn insert", "u64 insert",
+         "dyn get", "u64 get");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    uint64_t state = 1;
+    uint64_t *numbers = malloc(count * sizeof(uint64_t));
+    char **keys = malloc(count * sizeof(char *));
+    if (numbers == NULL || keys == NULL) {
+      return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+      numbers[i] = bench_random(&state);
+      keys[i] = malloc(21);
+      if (keys[i] == NULL) {
+        return 1;
+      }
+      sprintf(keys[i], "%llu", (unsigned long long)numbers[i]);
+    }
+
+    ht_dyn_table_t dyn;
+    ht_dyn_init(&dyn);
+    double start = bench_now();
+    for (size_t i = 0; i < count; i++) {
+      ht_dyn_insert(&dyn, keys[i], (float)i);
+    }
+    double dyn_insert = (bench_now() - start) * 1e9 / (double)count;
+
+    ht_u64_table_t u64;
+    ht_u64_init(&u64);
+    start = bench_now();
+    for (size_t i = 0; i < count; i++) {
+      ht_u64_insert(&u64, numbers[i], (float)i);
+    }
+    double u64_insert = (bench_now() - start) * 1e9 / (double)count;
+
+    // Both tables are searched for the same random sequence of keys
+    float sum = 0;
+    state = 2;
+    start = bench_now();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+      sum += *ht_dyn_get(&dyn, keys[bench_random(&state) % count]);
+    }
+    double dyn_get = (bench_now() - start) * 1e9 / LOOKUPS;
+
+    state = 2;
+    start = bench_now();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+      sum += *ht_u64_get(&u64, numbers[bench_random(&state) % count]);
+    }
+    double u64_get = (bench_now() - start) * 1e9 / LOOKUPS;
+    sink = sum;
+
+    printf("%10zu %12.1f %12.1f %12.1f %12.1f\n", count, dyn_insert,
+           u64_insert, dyn_get, u64_get);
+
+    ht_dyn_delete_all(&dyn);
+    ht_u64_delete_all(&u64);
+    bench_free_keys(keys, count);
+    free(numbers);
+  }
+
+  return 0;
+}
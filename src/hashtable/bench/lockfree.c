@@ -0,0 +1,120 @@
+/*
+ * Throughput of lookups without locks (ht_lf_table_t) against lookups taking
+ * a read lock of their shard (ht_conc_table_t), for 1 to 64 threads.
+ *
+ * Every thread performs its share of the operations: 99 % lookups of random
+ * existing keys and 1 % insertions (updates) of random keys.
+ */
+#include "../conc_table.h"
+#include "../lf_table.h"
+#include "bench_util.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ITEMS 100000
+#define OPERATIONS 4000000
+#define WRITE_PERCENT 1
+#define SHARDS 64
+
+// Work of one thread
+typedef struct worker {
+  void *table;
+  char **keys;
+  size_t operations;
+  uint64_t seed;
+  size_t found;
+} worker_t;
+
+void *run_conc(void *arg) {
+  worker_t *worker = arg;
+  ht_conc_table_t *table = worker->table;
+  uint64_t state = worker->seed;
+  float value;
+  worker->found = 0;
+  for (size_t i = 0; i < worker->operations; i++) {
+    uint64_t random = bench_random(&state);
+    char *key = worker->keys[random % ITEMS];
+    if ((random >> 32) % 100 < WRITE_PERCENT) {
+      ht_conc_insert(table, key, (float)i);
+    } else {
+      worker->found += ht_conc_get(table, key, &value);
+    }
+  }
+  return NULL;
+}
+
+void *run_lf(void *arg) {
+  worker_t *worker = arg;
+  ht_lf_table_t *table = worker->table;
+  ht_lf_reader_t *reader = ht_lf_register(table);
+  uint64_t state = worker->seed;
+  float value;
+  worker->found = 0;
+  for (size_t i = 0; i < worker->operations; i++) {
+    uint64_t random = bench_random(&state);
+    char *key = worker->keys[random % ITEMS];
+    if ((random >> 32) % 100 < WRITE_PERCENT) {
+      ht_lf_insert(table, key, (float)i);
+    } else {
+      worker->found += ht_lf_get(table, reader, key, &value);
+    }
+  }
+  ht_lf_unregister(reader);
+  return NULL;
+}
+
+// Returns millions of operations per second
+double measure(void *table, void *(*routine)(void *), size_t thread_count,
+               char **keys) {
+  pthread_t threads[64];
+  worker_t workers[64];
+  double start = bench_now();
+  for (size_t t = 0; t < thread_count; t++) {
+    workers[t] = (worker_t){table, keys, OPERATIONS / thread_count, t + 1, 0};
+    pthread_create(&threads[t], NULL, routine, &workers[t]);
+  }
+  for (size_t t = 0; t < thread_count; t++) {
+    pthread_join(threads[t], NULL);
+  }
+  double elapsed = bench_now() - start;
+
+  return (double)(OPERATIONS / thread_count * thread_count) / elapsed / 1e6;
+}
+
+int main() {
+  const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+  printf("Read-mostly workload: %d items, %d %% writes, %d operations per "
+         "run, %d shards\n",
+         ITEMS, WRITE_PERCENT, OPERATIONS, SHARDS);
+  printf("Throughput in millions of operations per second\n\n");
+  printf("%8s %12s %12s %8s\n", "threads", "rwlock", "lock-free", "speedup");
+
+  char **keys = bench_keys(ITEMS, "", 1);
+
+  ht_conc_table_t conc;
+  ht_lf_table_t *lf = malloc(sizeof(ht_lf_table_t));
+  if (lf == NULL || !ht_conc_init(&conc, SHARDS) || !ht_lf_init(lf, SHARDS)) {
+    return 1;
+  }
+  for (size_t i = 0; i < ITEMS; i++) {
+    ht_conc_insert(&conc, keys[i], (float)i);
+    ht_lf_insert(lf, keys[i], (float)i);
+  }
+
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]);
+       i++) {
+    double locked = measure(&conc, run_conc, thread_counts[i], keys);
+    double lock_free = measure(lf, run_lf, thread_counts[i], keys);
+    printf("%8zu %12.2f %12.2f %7.2fx\n", thread_counts[i], locked, lock_free,
+           lock_free / locked);
+  }
+
+  ht_conc_destroy(&conc);
+  ht_lf_destroy(lf);
+  free(lf);
+  bench_free_keys(keys, ITEMS);
+
+  return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Benchmark of lookups in the frozen table with minimal perfect hashing
+ * against ht_get of the chained table it is built from (MAX_HT_SIZE buckets).
+ */
+#include "../hashtable.h"
+#include "../mph.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LOOKUPS 2000000
+
+volatile float sink;
+
+int main() {
+  const size_t sizes[] = {15, 101, 1000, 10000, 100000};
+
+  printf("Read-only table: ht_get (%d buckets) vs ht_mph_get\n", MAX_HT_SIZE);
+  printf("Build in milliseconds, lookups in nanoseconds per lookup\n\n");
+  printf("%10s %10s %12s %12s %8s\n", "items", "build", "ht_get", "mph_get",
+         "speedup");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+    char **lookups = bench_keys(count, "", 1);
+    bench_shuffle(lookups, count, 2);
+
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    if (table == NULL) {
+      return 1;
+    }
+    ht_init(table);
+    for (size_t i = 0; i < count; i++) {
+      ht_insert(table, keys[i], (float)i);
+    }
+
+    ht_mph_table_t mph;
+    double start = bench_now();
+    if (!ht_mph_build(&mph, table)) {
+      return 1;
+    }
+    double build = (bench_now() - start) * 1e3;
+
+    float sum = 0;
+    start = bench_now();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+      sum += *ht_get(table, lookups[i % count]);
+    }
+    double chained = (bench_now() - start) * 1e9 / LOOKUPS;
+
+    start = bench_now();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+      sum += *ht_mph_get(&mph, lookups[i % count]);
+    }
+    double perfect = (bench_now() - start) * 1e9 / LOOKUPS;
+    sink = sum;
+
+    printf("%10zu %10.2f %12.1f %12.1f %7.2fx\n", count, build, chained,
+           perfect, chained / perfect);
+
+    ht_mph_destroy(&mph);
+    ht_delete_all(table);
+    free(table);
+    bench_free_keys(keys, count);
+    bench_free_keys(lookups, count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Benchmark of iterating over all the items: walking the buckets of the
+ * dynamic table against the cursor of the insertion-ordered table. Both tables
+ * are loaded with the same keys and then most of them are deleted, so the
+ * dynamic table keeps its bucket array while there are only a few items.
+ * The first iteration of the ordered table compacts its deleted entries.
+ */
+#include "../dyn_table.h"
+#include "../ordered.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Iterations are repeated until this many items (live or not) are passed
+#define WORK 100000000
+
+volatile float sink;
+
+double walk_buckets(ht_dyn_table_t *table, size_t rounds) {
+  float sum = 0;
+  double start = bench_now();
+  for (size_t r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < table->size; i++) {
+      for (ht_item_t *item = table->buckets[i]; item != NULL;
+           item = item->next) {
+        sum += item->value;
+      }
+    }
+  }
+  sink = sum;
+
+  return (bench_now() - start) * 1e6 / (double)rounds;
+}
+
+double walk_cursor(ht_ord_table_t *table, size_t rounds) {
+  float sum = 0;
+  double start = bench_now();
+  for (size_t r = 0; r < rounds; r++) {
+    ht_ord_cursor_t cursor;
+    ht_ord_cursor_init(table, &cursor);
+    ht_ord_entry_t *entry;
+    while ((entry = ht_ord_next(table, &cursor)) != NULL) {
+      sum += entry->value;
+    }
+  }
+  sink = sum;
+
+  return (bench_now() - start) * 1e6 / (double)rounds;
+}
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000};
+  const int kept[] = {100, 10, 1};
+
+  printf("Iteration over all items: ht_dyn_table_t buckets vs ht_ord cursor\n");
+  printf("Microseconds per full iteration\n\n");
+  printf("%10s %6s %10s %12s %12s\n", "inserted", "kept", "items",
+         "buckets", "cursor");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+
+    for (size_t k = 0; k < sizeof(kept) / sizeof(kept[0]); k++) {
+      ht_dyn_table_t dyn;
+      ht_ord_table_t ord;
+      ht_dyn_init(&dyn);
+      ht_ord_init(&ord);
+      for (size_t i = 0; i < count; i++) {
+        ht_dyn_insert(&dyn, keys[i], (float)i);
+        ht_ord_insert(&ord, keys[i], (float)i);
+      }
+      for (size_t i = 0; i < count; i++) {
+        if (i % 100 >= (size_t)kept[k]) {
+          ht_dyn_delete(&dyn, keys[i]);
+          ht_ord_delete(&ord, keys[i]);
+        }
+      }
+
+      size_t rounds = WORK / count;
+      double buckets = walk_buckets(&dyn, rounds);
+      double cursor = walk_cursor(&ord, rounds);
+      printf("%10zu %5d%% %10zu %12.1f %12.1f\n", count, kept[k], ord.count,
+             buckets, cursor);
+
+      ht_dyn_delete_all(&dyn);
+      ht_ord_delete_all(&ord);
+    }
+
+    bench_free_keys(keys, count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Load factor sweep of ht_table_t operations. The same file is built against
+ * robin/hashtable.c (Robin Hood open addressing, BENCH_ROBIN defined) and
+ * against hashtable.c (chained synonyms), both with MAX_HT_SIZE slots.
+ */
+#include "../hashtable.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define OPERATIONS 2000000
+
+// Insertion into an almost full open addressing table walks long clusters
+#define CHURN_OPERATIONS 100000
+
+volatile float sink;
+
+int main() {
+  const int loads[] = {50, 70, 80, 90, 95, 99};
+
+#ifdef BENCH_ROBIN
+  printf("Robin Hood open addressing, %d slots\n", MAX_HT_SIZE);
+#else
+  printf("Chained synonyms, %d buckets\n", MAX_HT_SIZE);
+#endif
+  printf("Nanoseconds per operation (churn = delete + insert)\n\n");
+  printf("%6s %10s %10s %10s %10s\n", "load", "items", "hit", "miss",
+         "churn");
+
+  HT_SIZE = MAX_HT_SIZE;
+  for (size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+    size_t count = (size_t)HT_SIZE * (size_t)loads[l] / 100;
+    char **keys = bench_keys(count, "", 1);
+    char **lookups = bench_keys(count, "", 1);
+    char **misses = bench_keys(count, "miss-", 2);
+    bench_shuffle(lookups, count, 3);
+
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    if (table == NULL) {
+      return 1;
+    }
+    ht_init(table);
+    for (size_t i = 0; i < count; i++) {
+      ht_insert(table, keys[i], (float)i);
+    }
+
+    float sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < OPERATIONS; i++) {
+      sum += *ht_get(table, lookups[i % count]);
+    }
+    double hit = (bench_now() - start) * 1e9 / OPERATIONS;
+
+    size_t found = 0;
+    start = bench_now();
+    for (size_t i = 0; i < OPERATIONS; i++) {
+      found += ht_get(table, misses[i % count]) != NULL;
+    }
+    double miss = (bench_now() - start) * 1e9 / OPERATIONS;
+    sink = sum + (float)found;
+
+    // Deleted key is inserted back, so the load factor stays the same
+    start = bench_now();
+    for (size_t i = 0; i < CHURN_OPERATIONS; i++) {
+      char *key = lookups[i % count];
+      ht_delete(table, key);
+      ht_insert(table, key, (float)i);
+    }
+    double churn = (bench_now() - start) * 1e9 / CHURN_OPERATIONS;
+
+    printf("%5d%% %10zu %10.1f %10.1f %10.1f\n", loads[l], count, hit, miss,
+           churn);
+
+    ht_delete_all(table);
+    free(table);
+    bench_free_keys(keys, count);
+    bench_free_keys(lookups, count);
+    bench_free_keys(misses, count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Benchmark of startup: rebuilding the table by insertions against opening
+ * its snapshot (and serving the first lookups from the mapping).
+ */
+#include "../snapshot.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LOOKUPS 1000000
+#define SNAPSHOT_PATH "bench-snapshot.tmp"
+
+volatile float sink;
+
+int main() {
+  const size_t sizes[] = {1000, 100000, 1000000, 4000000};
+
+  printf("Startup: rebuilding by ht_dyn_insert vs opening a snapshot\n");
+  printf("Times in milliseconds, lookups in nanoseconds per lookup\n\n");
+  printf("%10s %10s %10s %10s %12s %12s\n", "items", "rebuild", "write",
+         "open", "dyn get", "snap get");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+    char **lookups = bench_keys(count, "", 1);
+    bench_shuffle(lookups, count, 2);
+
+    double start = bench_now();
+    ht_dyn_table_t table;
+    ht_dyn_init(&table);
+    for (size_t i = 0; i < count; i++) {
+      ht_dyn_insert(&table, keys[i], (float)i);
+    }
+    double rebuild = (bench_now() - start) * 1e3;
+
+    start = bench_now();
+    if (!ht_snap_write(&table, SNAPSHOT_PATH)) {
+      return 1;
+    }
+    double write = (bench_now() - start) * 1e3;
+
+    start = bench_now();
+    ht_snap_t snap;
+    if (!ht_snap_open(&snap, SNAPSHOT_PATH)) {
+      return 1;
+    }
+    double open = (bench_now() - start) * 1e3;
+
+    float sum = 0;
+    start = bench_now();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+      sum += *ht_dyn_get(&table, lookups[i % count]);
+    }
+    double dyn_get = (bench_now() - start) * 1e9 / LOOKUPS;
+
+    start = bench_now();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+      sum += *ht_snap_get(&snap, lookups[i % count]);
+    }
+    double snap_get = (bench_now() - start) * 1e9 / LOOKUPS;
+    sink = sum;
+
+    printf("%10zu %10.2f %10.2f %10.3f %12.1f %12.1f\n", count, rebuild, write,
+           open, dyn_get, snap_get);
+
+    ht_snap_close(&snap);
+    ht_dyn_delete_all(&table);
+    remove(SNAPSHOT_PATH);
+    bench_free_keys(keys, count);
+    bench_free_keys(lookups, count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,335 @@
+/*
+ * Benchmark suite of the fixed size table (ht_table_t) and the dynamic table
+ * (ht_dyn_table_t).
+ *
+ * Every table is filled with realistic key sets of growing sizes: short words,
+ * URLs, UUIDs and anagrams (permutations of the same letters, they all
+ * collided when get_hash summed the key bytes). Throughput is measured by
+ * loops of the operations, latency percentiles by timing every operation
+ * separately (including the overhead of reading the clock).
+ *
+ * Results are printed as CSV, one line per table, key set, size and operation,
+ * so the runs can be compared by scripts.
+ *
+ * Usage: hashtable-bench [max_items [wy|fnv1a|additive]]
+ */
+#include "../dyn_table.h"
+#include "../hash.h"
+#include "../hashtable.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The fixed table needs a prime number of buckets for the biggest key set
+#if MAX_HT_SIZE < 1000003
+#error "compile the suite with -DMAX_HT_SIZE=1000003"
+#endif
+
+#define ANAGRAM_LENGTH 12
+
+enum { OP_INSERT, OP_GET, OP_DELETE };
+
+// Operations of one of the benchmarked tables
+typedef struct suite_table {
+  const char *name;                       // name printed in the results
+  void (*init)(int buckets);              // empties the table
+  void (*insert)(char *key, float value); // inserts the item
+  float *(*get)(char *key);               // returns value of the key or NULL
+  void (*delete)(char *key);              // deletes the key
+  void (*delete_all)(void);               // deletes all the items
+} suite_table_t;
+
+// Generator of the index-th key of a key set
+typedef char *(*suite_key_fn_t)(size_t index, uint64_t *state);
+
+// Key set of the benchmark
+typedef struct suite_keys {
+  const char *name;  // name printed in the results
+  suite_key_fn_t fn; // generator of the keys
+} suite_keys_t;
+
+// Latency percentiles of one operation in nanoseconds
+typedef struct suite_latency {
+  double p50;
+  double p99;
+  double p999;
+} suite_latency_t;
+
+volatile float sink;
+
+ht_table_t *fixed;
+ht_dyn_table_t dyn;
+ht_hash_fn_t hash_function = ht_hash_wy;
+
+void fixed_init(int buckets) {
+  HT_SIZE = buckets;
+  ht_init(fixed);
+}
+
+void fixed_insert(char *key, float value) { ht_insert(fixed, key, value); }
+
+float *fixed_get(char *key) { return ht_get(fixed, key); }
+
+void fixed_delete(char *key) { ht_delete(fixed, key); }
+
+void fixed_delete_all(void) { ht_delete_all(fixed); }
+
+void dyn_init(int buckets) {
+  (void)buckets;
+  ht_dyn_init(&dyn);
+  ht_dyn_set_hash(&dyn, hash_function, ht_hash_random_seed());
+}
+
+void dyn_insert(char *key, float value) { ht_dyn_insert(&dyn, key, value); }
+
+float *dyn_get(char *key) { return ht_dyn_get(&dyn, key); }
+
+void dyn_delete(char *key) { ht_dyn_delete(&dyn, key); }
+
+void dyn_delete_all(void) { ht_dyn_delete_all(&dyn); }
+
+/*
+ * Writes the pronounceable word with the given number (unique for every
+ * number) into the buffer.
+ */
+void write_word(char *buffer, size_t number) {
+  static const char consonants[] = "bcdfghjklmnprstvz";
+  static const char vowels[] = "aeiou";
+  const size_t syllables = (sizeof(consonants) - 1) * (sizeof(vowels) - 1);
+
+  size_t length = 0;
+  do {
+    size_t syllable = number % syllables;
+    buffer[length++] = consonants[syllable / (sizeof(vowels) - 1)];
+    buffer[length++] = vowels[syllable % (sizeof(vowels) - 1)];
+    number /= syllables;
+  } while (number != 0);
+  buffer[length] = '\0';
+}
+
+char *word_key(size_t index, uint64_t *state) {
+  (void)state;
+  char *key = malloc(32);
+  write_word(key, index);
+  return key;
+}
+
+char *url_key(size_t index, uint64_t *state) {
+  char host[32], path[32];
+  write_word(host, bench_random(state) % 2000);
+  write_word(path, index);
+
+  char *key = malloc(96);
+  snprintf(key, 96, "https://www.%s.com/articles/%s?id=%zu", host, path, index);
+  return key;
+}
+
+char *uuid_key(size_t index, uint64_t *state) {
+  (void)index;
+  // Random UUID (version 4, variant 1)
+  uint64_t high = (bench_random(state) & ~0xf000ULL) | 0x4000ULL;
+  uint64_t low = (bench_random(state) >> 2) | 0x8000000000000000ULL;
+
+  char *key = malloc(37);
+  snprintf(key, 37, "%08x-%04x-%04x-%04x-%012llx", (unsigned)(high >> 32),
+           (unsigned)(high >> 16) & 0xffff, (unsigned)high & 0xffff,
+           (unsigned)(low >> 48), (unsigned long long)low & 0xffffffffffffULL);
+  return key;
+}
+
+char *anagram_key(size_t index, uint64_t *state) {
+  (void)state;
+  char letters[] = "abcdefghijkl";
+  char *key = malloc(ANAGRAM_LENGTH + 1);
+
+  // Index in the factorial number system selects one of the permutations
+  for (int i = 0; i < ANAGRAM_LENGTH; i++) {
+    size_t pick = index % (size_t)(ANAGRAM_LENGTH - i);
+    index /= (size_t)(ANAGRAM_LENGTH - i);
+    key[i] = letters[pick];
+    memmove(letters + pick, letters + pick + 1, ANAGRAM_LENGTH - i - pick);
+  }
+  key[ANAGRAM_LENGTH] = '\0';
+
+  return key;
+}
+
+char **make_keys(suite_key_fn_t fn, size_t first, size_t count,
+                 uint64_t seed) {
+  char **keys = malloc(count * sizeof(char *));
+  for (size_t i = 0; i < count; i++) {
+    keys[i] = fn(first + i, &seed);
+  }
+
+  return keys;
+}
+
+static inline float run_op(const suite_table_t *table, int op, char *key,
+                           size_t i) {
+  switch (op) {
+  case OP_INSERT:
+    table->insert(key, (float)i);
+    return 0;
+  case OP_GET: {
+    float *value = table->get(key);
+    return value != NULL ? *value : 1;
+  }
+  default:
+    table->delete(key);
+    return 0;
+  }
+}
+
+/*
+ * Runs the operation for all the keys, returns operations per second.
+ */
+double run_all(const suite_table_t *table, int op, char **keys,
+               size_t count) {
+  float sum = 0;
+  double start = bench_now();
+  for (size_t i = 0; i < count; i++) {
+    sum += run_op(table, op, keys[i], i);
+  }
+  double seconds = bench_now() - start;
+  sink = sum;
+
+  return (double)count / seconds;
+}
+
+int compare_doubles(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/*
+ * Times the operation for every key separately, returns the percentiles.
+ */
+suite_latency_t run_each(const suite_table_t *table, int op, char **keys,
+                         size_t count, double *times) {
+  float sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    double start = bench_now();
+    sum += run_op(table, op, keys[i], i);
+    times[i] = (bench_now() - start) * 1e9;
+  }
+  sink = sum;
+
+  qsort(times, count, sizeof(double), compare_doubles);
+  suite_latency_t latency = {times[count / 2], times[count * 99 / 100],
+                             times[count * 999 / 1000]};
+  return latency;
+}
+
+void print_result(const char *hash, const char *table, const char *keys,
+                  size_t count, const char *op, double rate,
+                  const suite_latency_t *latency) {
+  printf("%s,%s,%s,%zu,%s,%.0f", hash, table, keys, count, op, rate);
+  if (latency != NULL) {
+    printf(",%.0f,%.0f,%.0f\n", latency->p50, latency->p99, latency->p999);
+  } else {
+    printf(",,,\n");
+  }
+}
+
+void run(const char *hash, const suite_table_t *table,
+         const suite_keys_t *key_set, size_t count, int buckets,
+         double *times) {
+  char **keys = make_keys(key_set->fn, 0, count, 1);
+  char **misses = make_keys(key_set->fn, count, count, 2);
+  char **hits = malloc(count * sizeof(char *));
+  memcpy(hits, keys, count * sizeof(char *));
+  bench_shuffle(hits, count, 3);
+
+  table->init(buckets);
+
+  double insert_rate = run_all(table, OP_INSERT, keys, count);
+  double hit_rate = run_all(table, OP_GET, hits, count);
+  suite_latency_t hit = run_each(table, OP_GET, hits, count, times);
+  double miss_rate = run_all(table, OP_GET, misses, count);
+  suite_latency_t miss = run_each(table, OP_GET, misses, count, times);
+  double delete_rate = run_all(table, OP_DELETE, hits, count);
+
+  // Latencies of the modifications need another filling of the table, it
+  // starts from a new table so that the growth is timed again
+  table->delete_all();
+  table->init(buckets);
+  suite_latency_t insert = run_each(table, OP_INSERT, keys, count, times);
+  suite_latency_t delete = run_each(table, OP_DELETE, hits, count, times);
+
+  run_all(table, OP_INSERT, keys, count);
+  double start = bench_now();
+  table->delete_all();
+  double delete_all_rate = (double)count / (bench_now() - start);
+
+  print_result(hash, table->name, key_set->name, count, "insert", insert_rate,
+               &insert);
+  print_result(hash, table->name, key_set->name, count, "hit", hit_rate, &hit);
+  print_result(hash, table->name, key_set->name, count, "miss", miss_rate,
+               &miss);
+  print_result(hash, table->name, key_set->name, count, "delete", delete_rate,
+               &delete);
+  print_result(hash, table->name, key_set->name, count, "delete_all",
+               delete_all_rate, NULL);
+  fflush(stdout);
+
+  free(hits);
+  bench_free_keys(keys, count);
+  bench_free_keys(misses, count);
+}
+
+int main(int argc, char *argv[]) {
+  // Numbers of items and prime numbers of buckets of the fixed table
+  const size_t sizes[] = {1000, 10000, 100000, 1000000};
+  const int buckets[] = {1009, 10007, 100003, 1000003};
+  const suite_table_t tables[] = {
+      {"fixed", fixed_init, fixed_insert, fixed_get, fixed_delete,
+       fixed_delete_all},
+      {"dyn", dyn_init, dyn_insert, dyn_get, dyn_delete, dyn_delete_all},
+  };
+  const suite_keys_t key_sets[] = {
+      {"words", word_key},
+      {"urls", url_key},
+      {"uuids", uuid_key},
+      {"anagrams", anagram_key},
+  };
+
+  size_t max_items = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+  const char *hash = argc > 2 ? argv[2] : "wy";
+  if (strcmp(hash, "wy") == 0) {
+    hash_function = ht_hash_wy;
+  } else if (strcmp(hash, "fnv1a") == 0) {
+    hash_function = ht_hash_fnv1a;
+  } else if (strcmp(hash, "additive") == 0) {
+    hash_function = ht_hash_additive;
+  } else {
+    fprintf(stderr, "Unknown hash function: %s\n", hash);
+    return 1;
+  }
+  ht_hash_function = hash_function;
+
+  fixed = malloc(sizeof(ht_table_t));
+  double *times = malloc(max_items * sizeof(double));
+  if (fixed == NULL || times == NULL) {
+    return 1;
+  }
+
+  printf("hash,table,keys,items,operation,ops_per_sec,p50_ns,p99_ns,p999_ns\n");
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    if (sizes[s] > max_items) {
+      break;
+    }
+
+    for (size_t k = 0; k < sizeof(key_sets) / sizeof(key_sets[0]); k++) {
+      for (size_t t = 0; t < sizeof(tables) / sizeof(tables[0]); t++) {
+        run(hash, &tables[t], &key_sets[k], sizes[s], buckets[s], times);
+      }
+    }
+  }
+
+  free(times);
+  free(fixed);
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Lookup benchmark of the chained table (ht_dyn_table_t) and the open
+ * addressing table (ht_swiss_table_t) with the same keys.
+ */
+#include "../dyn_table.h"
+#include "../swiss.h"
+#include "bench_util.h"
+#include <stdio.h>
+
+#define REPEAT_LOOKUPS 2000000
+
+volatile float sink;
+
+double bench_dyn(ht_dyn_table_t *table, char **keys, size_t count) {
+  size_t rounds = REPEAT_LOOKUPS / count + 1;
+  float sum = 0;
+  double start = bench_now();
+  for (size_t r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < count; i++) {
+      float *value = ht_dyn_get(table, keys[i]);
+      sum += value != NULL ? *value : 1;
+    }
+  }
+  sink = sum;
+  return (bench_now() - start) * 1e9 / (double)(rounds * count);
+}
+
+double bench_swiss(ht_swiss_table_t *table, char **keys, size_t count) {
+  size_t rounds = REPEAT_LOOKUPS / count + 1;
+  float sum = 0;
+  double start = bench_now();
+  for (size_t r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < count; i++) {
+      float *value = ht_swiss_get(table, keys[i]);
+      sum += value != NULL ? *value : 1;
+    }
+  }
+  sink = sum;
+  return (bench_now() - start) * 1e9 / (double)(rounds * count);
+}
+
+int main() {
+  const size_t sizes[] = {1000, 10000, 100000, 1000000};
+
+  printf("Lookup benchmark: chained (ht_dyn) vs open addressing (ht_swiss)\n");
+  printf("Average time per lookup in nanoseconds\n\n");
+  printf("%10s %12s %12s %8s %12s %12s %8s\n", "items", "chained hit",
+         "swiss hit", "speedup", "chained miss", "swiss miss", "speedup");
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    size_t count = sizes[s];
+    char **keys = bench_keys(count, "", 1);
+    char **missing = bench_keys(count, "missing-", 2);
+
+    ht_dyn_table_t dyn;
+    ht_swiss_table_t swiss;
+    ht_dyn_init(&dyn);
+    ht_swiss_init(&swiss);
+    for (size_t i = 0; i < count; i++) {
+      ht_dyn_insert(&dyn, keys[i], (float)i);
+      ht_swiss_insert(&swiss, keys[i], (float)i);
+    }
+
+    // Lookups in different order than insertions
+    bench_shuffle(keys, count, 3);
+
+    double dyn_hit = bench_dyn(&dyn, keys, count);
+    double swiss_hit = bench_swiss(&swiss, keys, count);
+    double dyn_miss = bench_dyn(&dyn, missing, count);
+    double swiss_miss = bench_swiss(&swiss, missing, count);
+
+    printf("%10zu %12.1f %12.1f %7.2fx %12.1f %12.1f %7.2fx\n", count, dyn_hit,
+           swiss_hit, dyn_hit / swiss_hit, dyn_miss, swiss_miss,
+           dyn_miss / swiss_miss);
+
+    ht_dyn_delete_all(&dyn);
+    ht_swiss_delete_all(&swiss);
+    bench_free_keys(keys, count);
+    bench_free_keys(missing, count);
+  }
+
+  return 0;
+}
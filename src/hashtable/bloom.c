@@ -0,0 +1,114 @@
+/*
+ * Blocked Bloom filter
+ *
+ * Upper 32 bits of the hash select the block (the table uses the lower bits to
+ * select buckets). The hash is then multiplied by an odd constant and each
+ * 6 bits of the product select one bit in one word of the block, so every key
+ * sets HT_BLOOM_BLOCK_WORDS bits and a query is a few ANDs in one cache line.
+ */
+
+#include "bloom.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Size of a block in bytes
+#define BLOOM_BLOCK_SIZE (HT_BLOOM_BLOCK_WORDS * sizeof(uint64_t))
+
+static inline uint64_t *bloom_block(const ht_bloom_t *bloom, uint64_t hash) {
+    return bloom->blocks + ((hash >> 32) & (bloom->block_count - 1)) * HT_BLOOM_BLOCK_WORDS;
+}
+
+/*
+ * Returns the bit of the key in the word of its block.
+ */
+static inline uint64_t bloom_bit(uint64_t mixed, int word) {
+    return (uint64_t) 1 << ((mixed >> (6 * word)) & 63);
+}
+
+/*
+ * Initialization of an empty filter without blocks.
+ */
+void ht_bloom_init(ht_bloom_t *bloom) {
+    bloom->blocks = NULL;
+    bloom->memory = NULL;
+    bloom->block_count = 0;
+    bloom->capacity = 0;
+    bloom->added = 0;
+}
+
+/*
+ * Clears the filter and resizes it for the given number of keys.
+ *
+ * Returns false if there is not enough memory. The filter has no blocks then
+ * (it answers "maybe" to every query) and its capacity is unlimited, so the
+ * table doesn't try to reset it again and again.
+ */
+bool ht_bloom_reset(ht_bloom_t *bloom, size_t capacity) {
+    size_t block_count = 1;
+    while (block_count * BLOOM_BLOCK_SIZE * 8 < capacity * HT_BLOOM_BITS_PER_KEY) {
+        block_count *= 2;
+    }
+
+    if (block_count != bloom->block_count) {
+        ht_bloom_release(bloom);
+
+        // Blocks are aligned to cache lines manually (aligned_alloc isn't in C99)
+        if ((bloom->memory = malloc(block_count * BLOOM_BLOCK_SIZE + BLOOM_BLOCK_SIZE - 1)) == NULL) {
+            bloom->capacity = SIZE_MAX;
+            return false;
+        }
+        uintptr_t address = ((uintptr_t) bloom->memory + BLOOM_BLOCK_SIZE - 1) & ~(uintptr_t) (BLOOM_BLOCK_SIZE - 1);
+        bloom->blocks = (uint64_t *) address;
+        bloom->block_count = block_count;
+    }
+
+    memset(bloom->blocks, 0, block_count * BLOOM_BLOCK_SIZE);
+    bloom->capacity = block_count * BLOOM_BLOCK_SIZE * 8 / HT_BLOOM_BITS_PER_KEY;
+    bloom->added = 0;
+
+    return true;
+}
+
+/*
+ * Adds the key with the given hash into the filter.
+ */
+void ht_bloom_add(ht_bloom_t *bloom, uint64_t hash) {
+    bloom->added++;
+    if (bloom->blocks == NULL) {
+        return;
+    }
+
+    uint64_t *block = bloom_block(bloom, hash);
+    uint64_t mixed = hash * 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < HT_BLOOM_BLOCK_WORDS; i++) {
+        block[i] |= bloom_bit(mixed, i);
+    }
+}
+
+/*
+ * Returns false if the key with the given hash has surely not been added since
+ * the last reset, true if it may have been.
+ */
+bool ht_bloom_may_contain(const ht_bloom_t *bloom, uint64_t hash) {
+    if (bloom->blocks == NULL) {
+        return true;
+    }
+
+    const uint64_t *block = bloom_block(bloom, hash);
+    uint64_t mixed = hash * 0x9e3779b97f4a7c15ULL;
+    uint64_t missing = 0;
+    for (int i = 0; i < HT_BLOOM_BLOCK_WORDS; i++) {
+        // No branch per word, all the words are in the same cache line anyway
+        missing |= ~block[i] & bloom_bit(mixed, i);
+    }
+
+    return missing == 0;
+}
+
+/*
+ * Releases the blocks, the filter is empty again.
+ */
+void ht_bloom_release(ht_bloom_t *bloom) {
+    free(bloom->memory);
+    ht_bloom_init(bloom);
+}
@@ -0,0 +1,38 @@
+/*
+ * Header file for the blocked Bloom filter used by the dynamic table.
+ *
+ * Bits of every key are in one block of 64 bytes (a cache line), so a query
+ * touches one cache line only. The filter works with the full hashes the table
+ * has already computed, keys aren't hashed again. Keys can't be removed, the
+ * filter has to be reset and filled again.
+ */
+
+#ifndef IAL_HASHTABLE_BLOOM_H
+#define IAL_HASHTABLE_BLOOM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of 64-bit words in a block (one bit of every key is set in each word)
+#define HT_BLOOM_BLOCK_WORDS 8
+
+// Number of bits of the filter per expected key
+#define HT_BLOOM_BITS_PER_KEY 10
+
+// Blocked Bloom filter, filter without blocks answers "maybe" to everything
+typedef struct ht_bloom {
+  uint64_t *blocks;   // blocks aligned to 64 bytes, NULL if none
+  void *memory;       // allocated memory containing the blocks
+  size_t block_count; // number of blocks (power of two)
+  size_t capacity;    // number of keys the filter has been sized for
+  size_t added;       // number of keys added since the reset
+} ht_bloom_t;
+
+void ht_bloom_init(ht_bloom_t *bloom);
+bool ht_bloom_reset(ht_bloom_t *bloom, size_t capacity);
+void ht_bloom_add(ht_bloom_t *bloom, uint64_t hash);
+bool ht_bloom_may_contain(const ht_bloom_t *bloom, uint64_t hash);
+void ht_bloom_release(ht_bloom_t *bloom);
+
+#endif
@@ -0,0 +1,322 @@
+/*
+ * Bounded cache
+ *
+ * Lists of synonyms are the same as in ht_table_t (items are linked by their
+ * next pointers), but the items aren't allocated one by one: the whole array
+ * of capacity items is allocated by ht_cache_init and unused items are kept in
+ * a free list. Number of buckets is at least the capacity, so the lists stay
+ * short even in a full cache.
+ *
+ * CLOCK: a hit only sets the referenced bit. When an item has to be evicted,
+ * the hand goes around the array of items, clears the referenced bits and stops
+ * at the first item which hasn't been referenced since its last visit.
+ *
+ * LRU: items are in a doubly linked list ordered by their last usage, a hit
+ * moves the item to the front and the item at the back is evicted.
+ *
+ * Only the items of a full cache are evicted and every item is used by then,
+ * so the hand never meets an unused item.
+ */
+
+#include "cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline uint64_t cache_hash(ht_cache_t *cache, const char *key) {
+    return cache->hash(key, strlen(key), cache->seed);
+}
+
+/*
+ * Returns pointer to the link (bucket or next pointer of the previous synonym)
+ * leading to the item with the key. The link contains NULL if there is no such
+ * item.
+ */
+static ht_item_t **cache_find(ht_cache_t *cache, char *key, uint64_t hash) {
+    ht_item_t **link = &cache->buckets[hash & (cache->size - 1)];
+    while (*link != NULL && ((*link)->hash != hash || strcmp((*link)->key, key) != 0)) {
+        link = &(*link)->next;
+    }
+
+    return link;
+}
+
+/*
+ * Removes the item from the LRU list.
+ */
+static void cache_lru_unlink(ht_cache_t *cache, ht_cache_item_t *item) {
+    if (item->newer != NULL) {
+        item->newer->older = item->older;
+    } else {
+        cache->newest = item->older;
+    }
+
+    if (item->older != NULL) {
+        item->older->newer = item->newer;
+    } else {
+        cache->oldest = item->newer;
+    }
+}
+
+/*
+ * Puts the item at the front of the LRU list.
+ */
+static void cache_lru_push(ht_cache_t *cache, ht_cache_item_t *item) {
+    item->newer = NULL;
+    item->older = cache->newest;
+    if (cache->newest != NULL) {
+        cache->newest->newer = item;
+    } else {
+        cache->oldest = item;
+    }
+    cache->newest = item;
+}
+
+/*
+ * Marks the item as just used.
+ */
+static inline void cache_touch(ht_cache_t *cache, ht_cache_item_t *item) {
+    if (cache->policy == HT_CACHE_CLOCK) {
+        item->referenced = true;
+    } else if (cache->newest != item) {
+        cache_lru_unlink(cache, item);
+        cache_lru_push(cache, item);
+    }
+}
+
+/*
+ * Chooses the item to be evicted from the full cache.
+ */
+static ht_cache_item_t *cache_victim(ht_cache_t *cache) {
+    if (cache->policy == HT_CACHE_LRU) {
+        return cache->oldest;
+    }
+
+    // Every referenced item gets a second chance, so the hand stops in two rounds at most
+    for (;;) {
+        ht_cache_item_t *item = &cache->items[cache->hand];
+        cache->hand = cache->hand + 1 == cache->capacity ? 0 : cache->hand + 1;
+        if (!item->referenced) {
+            return item;
+        }
+        item->referenced = false;
+    }
+}
+
+/*
+ * Unlinks the item from its list of synonyms and from the LRU list.
+ */
+static void cache_remove(ht_cache_t *cache, ht_cache_item_t *item) {
+    ht_item_t **link = cache_find(cache, item->item.key, item->item.hash);
+    *link = item->item.next;
+
+    if (cache->policy == HT_CACHE_LRU) {
+        cache_lru_unlink(cache, item);
+    }
+
+    cache->count--;
+}
+
+/*
+ * Puts all the items into the free list.
+ */
+static void cache_clear(ht_cache_t *cache) {
+    memset(cache->buckets, 0, cache->size * sizeof(ht_item_t *));
+
+    cache->free = NULL;
+    for (size_t i = cache->capacity; i > 0; i--) {
+        ht_cache_item_t *item = &cache->items[i - 1];
+        item->item.key = NULL;
+        item->item.next = (ht_item_t *) cache->free;
+        cache->free = item;
+    }
+
+    cache->count = 0;
+    cache->hand = 0;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+}
+
+/*
+ * Initialization of the cache for at most capacity items (at least one) —
+ * call it before the first usage of the cache.
+ *
+ * All the items are allocated now. Returns false if there is not enough memory
+ * (the cache can't be used then).
+ */
+bool ht_cache_init(ht_cache_t *cache, size_t capacity, ht_cache_policy_t policy) {
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    size_t size = 1;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    cache->buckets = malloc(size * sizeof(ht_item_t *));
+    cache->items = malloc(capacity * sizeof(ht_cache_item_t));
+    if (cache->buckets == NULL || cache->items == NULL) {
+        free(cache->buckets);
+        free(cache->items);
+        return false;
+    }
+
+    cache->size = size;
+    cache->capacity = capacity;
+    cache->policy = policy;
+    cache->hash = ht_hash_wy;
+    cache->seed = ht_hash_random_seed();
+    memset(&cache->counters, 0, sizeof(cache->counters));
+    cache_clear(cache);
+
+    return true;
+}
+
+/*
+ * Changes hash function and seed of the cache.
+ *
+ * It can be done only while the cache is empty. Returns true if the function
+ * has been changed.
+ */
+bool ht_cache_set_hash(ht_cache_t *cache, ht_hash_fn_t hash, uint64_t seed) {
+    if (cache->count != 0) {
+        return false;
+    }
+
+    cache->hash = hash;
+    cache->seed = seed;
+
+    return true;
+}
+
+/*
+ * Getting value of the item from the cache.
+ *
+ * The lookup is counted as a hit or a miss and the found item becomes the most
+ * recently used one. Returns pointer to the value or NULL if the key isn't
+ * cached. The pointer is valid until the item is evicted.
+ */
+float *ht_cache_get(ht_cache_t *cache, char *key) {
+    ht_item_t *item = *cache_find(cache, key, cache_hash(cache, key));
+    if (item == NULL) {
+        cache->counters.misses++;
+        return NULL;
+    }
+
+    cache->counters.hits++;
+    cache_touch(cache, (ht_cache_item_t *) item);
+
+    return &item->value;
+}
+
+/*
+ * Getting value of the item without counting the lookup and without changing
+ * the order of eviction.
+ */
+float *ht_cache_peek(ht_cache_t *cache, char *key) {
+    ht_item_t *item = *cache_find(cache, key, cache_hash(cache, key));
+
+    return item != NULL ? &item->value : NULL;
+}
+
+/*
+ * Inserting an item into the cache.
+ *
+ * If the key is already cached, only its value is replaced. Either way the item
+ * becomes the most recently used one. If the cache is full, the coldest item is
+ * evicted; its key is returned (so the caller can release it), NULL is returned
+ * if nothing has been evicted.
+ */
+char *ht_cache_insert(ht_cache_t *cache, char *key, float value) {
+    uint64_t hash = cache_hash(cache, key);
+    ht_item_t **link = cache_find(cache, key, hash);
+    if (*link != NULL) {
+        // Item is already in the cache --> only change its value
+        (*link)->value = value;
+        cache_touch(cache, (ht_cache_item_t *) *link);
+        cache->counters.updates++;
+
+        return NULL;
+    }
+
+    char *evicted = NULL;
+    ht_cache_item_t *item = cache->free;
+    if (item != NULL) {
+        cache->free = (ht_cache_item_t *) item->item.next;
+    } else {
+        item = cache_victim(cache);
+        evicted = item->item.key;
+        cache_remove(cache, item);
+        cache->counters.evictions++;
+    }
+
+    // New item is the first synonym (the bucket is found again, the eviction could change it)
+    ht_item_t **bucket = &cache->buckets[hash & (cache->size - 1)];
+    item->item.key = key;
+    item->item.value = value;
+    item->item.next = *bucket;
+    item->item.hash = hash;
+    *bucket = &item->item;
+
+    // Item gets its second chance only by a hit (evicted slot is right behind the hand anyway)
+    item->referenced = false;
+    if (cache->policy == HT_CACHE_LRU) {
+        cache_lru_push(cache, item);
+    }
+
+    cache->count++;
+    cache->counters.inserts++;
+
+    return evicted;
+}
+
+/*
+ * Deleting an item from the cache.
+ *
+ * Returns true if the item has been deleted, false if the key isn't cached.
+ */
+bool ht_cache_delete(ht_cache_t *cache, char *key) {
+    ht_item_t *item = *cache_find(cache, key, cache_hash(cache, key));
+    if (item == NULL) {
+        return false;
+    }
+
+    cache_remove(cache, (ht_cache_item_t *) item);
+    item->key = NULL;
+    item->next = (ht_item_t *) cache->free;
+    cache->free = (ht_cache_item_t *) item;
+
+    return true;
+}
+
+/*
+ * Deleting all items from the cache.
+ *
+ * The cache keeps its capacity and counters, only the items are dropped.
+ */
+void ht_cache_delete_all(ht_cache_t *cache) {
+    cache_clear(cache);
+}
+
+/*
+ * Releases all the memory of the cache. It has to be initialized again before
+ * the next usage.
+ */
+void ht_cache_destroy(ht_cache_t *cache) {
+    free(cache->buckets);
+    free(cache->items);
+
+    cache->buckets = NULL;
+    cache->items = NULL;
+    cache->size = 0;
+    cache->capacity = 0;
+    cache->count = 0;
+    cache->free = NULL;
+}
+
+/*
+ * Sets all the counters of the cache to zero.
+ */
+void ht_cache_reset_counters(ht_cache_t *cache) {
+    memset(&cache->counters, 0, sizeof(cache->counters));
+}
@@ -0,0 +1,72 @@
+/*
+ * Header file for the bounded cache built on a hash table.
+ *
+ * The cache holds at most the given number of items. All the items are
+ * allocated at once by the initialization; when the cache is full, inserting a
+ * new key evicts the coldest item and reuses it. The coldest item is chosen
+ * either by CLOCK (a hit only sets the referenced bit of the item) or by LRU
+ * (a hit moves the item to the front of a list threaded through the items).
+ */
+
+#ifndef IAL_HASHTABLE_CACHE_H
+#define IAL_HASHTABLE_CACHE_H
+
+#include "hash.h"
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Eviction policies of the cache
+typedef enum ht_cache_policy {
+  HT_CACHE_CLOCK, // second chance for the items referenced since the last visit
+  HT_CACHE_LRU    // least recently used item
+} ht_cache_policy_t;
+
+// Item of the cache
+typedef struct ht_cache_item {
+  ht_item_t item;              // key, value and list of synonyms
+  struct ht_cache_item *newer; // more recently used item (LRU only)
+  struct ht_cache_item *older; // less recently used item (LRU only)
+  bool referenced;             // item has been used (CLOCK only)
+} ht_cache_item_t;
+
+// Counters of the cache operations
+typedef struct ht_cache_counters {
+  size_t hits;      // lookups which found the key
+  size_t misses;    // lookups which didn't find it
+  size_t inserts;   // insertions of new items
+  size_t updates;   // insertions of already cached keys
+  size_t evictions; // items evicted by insertions
+} ht_cache_counters_t;
+
+// Bounded cache
+typedef struct ht_cache {
+  ht_item_t **buckets;          // lists of synonyms (size is a power of two)
+  size_t size;                  // number of buckets
+  ht_cache_item_t *items;       // all the items
+  size_t capacity;              // maximum number of cached items
+  size_t count;                 // number of cached items
+  ht_cache_item_t *free;        // unused items (linked by item.next)
+  size_t hand;                  // next item visited by CLOCK
+  ht_cache_item_t *newest;      // most recently used item (LRU only)
+  ht_cache_item_t *oldest;      // least recently used item (LRU only)
+  ht_cache_policy_t policy;     // eviction policy
+  ht_hash_fn_t hash;            // hash function
+  uint64_t seed;                // seed of the hash function
+  ht_cache_counters_t counters; // counters of the operations
+} ht_cache_t;
+
+bool ht_cache_init(ht_cache_t *cache, size_t capacity,
+                   ht_cache_policy_t policy);
+float *ht_cache_get(ht_cache_t *cache, char *key);
+float *ht_cache_peek(ht_cache_t *cache, char *key);
+char *ht_cache_insert(ht_cache_t *cache, char *key, float value);
+bool ht_cache_delete(ht_cache_t *cache, char *key);
+void ht_cache_delete_all(ht_cache_t *cache);
+void ht_cache_destroy(ht_cache_t *cache);
+
+bool ht_cache_set_hash(ht_cache_t *cache, ht_hash_fn_t hash, uint64_t seed);
+void ht_cache_reset_counters(ht_cache_t *cache);
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Thread-safe hash table made of shards
+ *
+ * The key is hashed only once: upper bits of the hash select the shard, the
+ * whole hash is passed to the shard's ht_dyn_*_hashed function (which uses
+ * lower bits to select the bucket). All the shards share the same hash
+ * function and seed, so the hash computed outside the lock is valid for any
+ * of them.
+ *
+ * Initialization, ht_conc_set_hash and ht_conc_destroy must not run in
+ * parallel with other operations over the same table, everything else can.
+ */
+
+#include "conc_table.h"
+#include <stdlib.h>
+
+/*
+ * Returns the shard which the key with the hash belongs to.
+ */
+static inline ht_conc_shard_t *conc_shard(ht_conc_table_t *table, uint64_t hash) {
+    return &table->shards[(size_t) (hash >> 48) & (table->shard_count - 1)];
+}
+
+/*
+ * Hashes the key (hash function and seed can't change while the table is used
+ * concurrently, so no lock is needed).
+ */
+static inline uint64_t conc_hash(ht_conc_table_t *table, char *key) {
+    return ht_dyn_hash(&table->shards[0].table, key);
+}
+
+/*
+ * Initialization of the table — call it before the first usage of the table.
+ *
+ * The number of shards is rounded up to a power of two. Returns false if
+ * there is not enough memory (the table can't be used then).
+ */
+bool ht_conc_init(ht_conc_table_t *table, size_t shards) {
+    return ht_conc_init_with(table, shards, 0);
+}
+
+/*
+ * Initialization of the table with HT_DYN_* flags used by all the shards
+ * (except HT_DYN_STATS).
+ */
+bool ht_conc_init_with(ht_conc_table_t *table, size_t shards, unsigned flags) {
+    // Readers of one shard run in parallel, they can't update its counters
+    flags &= ~(unsigned) HT_DYN_STATS;
+
+    size_t count = 1;
+    while (count < shards && count < HT_CONC_MAX_SHARDS) {
+        count *= 2;
+    }
+
+    table->shard_count = 0;
+    if ((table->shards = malloc(count * sizeof(ht_conc_shard_t))) == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (pthread_rwlock_init(&table->shards[i].lock, NULL) != 0) {
+            // Only already initialized shards are destroyed
+            table->shard_count = i;
+            ht_conc_destroy(table);
+
+            return false;
+        }
+
+        ht_dyn_init_with(&table->shards[i].table, flags);
+    }
+    table->shard_count = count;
+
+    // Every shard has got its own random seed, but hashes must be the same
+    ht_dyn_table_t *first = &table->shards[0].table;
+    ht_conc_set_hash(table, first->hash, first->seed);
+
+    return true;
+}
+
+/*
+ * Changes hash function and seed of all the shards.
+ *
+ * It can be done only while the table is empty. Returns true if the function
+ * has been changed.
+ */
+bool ht_conc_set_hash(ht_conc_table_t *table, ht_hash_fn_t hash, uint64_t seed) {
+    if (ht_conc_count(table) != 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ht_dyn_set_hash(&table->shards[i].table, hash, seed);
+    }
+
+    return true;
+}
+
+/*
+ * Checks if there is an item with the key in the table.
+ */
+bool ht_conc_contains(ht_conc_table_t *table, char *key) {
+    uint64_t hash = conc_hash(table, key);
+    ht_conc_shard_t *shard = conc_shard(table, hash);
+
+    pthread_rwlock_rdlock(&shard->lock);
+    bool found = ht_dyn_search_hashed(&shard->table, key, hash) != NULL;
+    pthread_rwlock_unlock(&shard->lock);
+
+    return found;
+}
+
+/*
+ * Getting value of the item from the table.
+ *
+ * The value is copied into the value parameter. Returns false if there is no
+ * item with the key (value isn't changed then).
+ */
+bool ht_conc_get(ht_conc_table_t *table, char *key, float *value) {
+    uint64_t hash = conc_hash(table, key);
+    ht_conc_shard_t *shard = conc_shard(table, hash);
+
+    pthread_rwlock_rdlock(&shard->lock);
+    ht_item_t *item = ht_dyn_search_hashed(&shard->table, key, hash);
+    if (item != NULL) {
+        *value = item->value;
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return item != NULL;
+}
+
+/*
+ * Inserting a new item into the table.
+ *
+ * If there already is an item with the key, only its value is replaced.
+ */
+void ht_conc_insert(ht_conc_table_t *table, char *key, float value) {
+    uint64_t hash = conc_hash(table, key);
+    ht_conc_shard_t *shard = conc_shard(table, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    ht_dyn_insert_hashed(&shard->table, key, hash, value);
+    pthread_rwlock_unlock(&shard->lock);
+}
+
+/*
+ * Deleting an item from the table.
+ *
+ * If there is no item with the key, nothing happens.
+ */
+void ht_conc_delete(ht_conc_table_t *table, char *key) {
+    uint64_t hash = conc_hash(table, key);
+    ht_conc_shard_t *shard = conc_shard(table, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    ht_dyn_delete_hashed(&shard->table, key, hash);
+    pthread_rwlock_unlock(&shard->lock);
+}
+
+/*
+ * Deleting all items from the table.
+ *
+ * Shards are cleared one after another, so items inserted concurrently into
+ * already cleared shards are kept.
+ */
+void ht_conc_delete_all(ht_conc_table_t *table) {
+    for (size_t i = 0; i < table->shard_count; i++) {
+        pthread_rwlock_wrlock(&table->shards[i].lock);
+        ht_dyn_delete_all(&table->shards[i].table);
+        pthread_rwlock_unlock(&table->shards[i].lock);
+    }
+}
+
+/*
+ * Releasing the table — all items are deleted and locks are destroyed. The
+ * table must be initialized again before the next usage.
+ */
+void ht_conc_destroy(ht_conc_table_t *table) {
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ht_dyn_delete_all(&table->shards[i].table);
+        pthread_rwlock_destroy(&table->shards[i].lock);
+    }
+
+    free(table->shards);
+    table->shards = NULL;
+    table->shard_count = 0;
+}
+
+/*
+ * Returns number of items in the table (shards are counted one by one, so it
+ * is only approximate while other threads modify the table).
+ */
+size_t ht_conc_count(ht_conc_table_t *table) {
+    size_t count = 0;
+    for (size_t i = 0; i < table->shard_count; i++) {
+        pthread_rwlock_rdlock(&table->shards[i].lock);
+        count += table->shards[i].table.count;
+        pthread_rwlock_unlock(&table->shards[i].lock);
+    }
+
+    return count;
+}
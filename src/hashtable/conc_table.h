@@ -0,0 +1,51 @@
+/*
+ * Header file for the thread-safe (sharded) hash table.
+ *
+ * Keys are distributed into shards by their hash. Every shard is an ordinary
+ * ht_dyn_table_t with its own size, protected by its own reader-writer lock,
+ * so readers run in parallel and writers only block operations on the same
+ * shard. Values are returned as copies, because a pointer into a shard isn't
+ * valid once its lock is released.
+ */
+
+#ifndef IAL_HASHTABLE_CONC_TABLE_H
+#define IAL_HASHTABLE_CONC_TABLE_H
+
+#include "dyn_table.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Maximum number of shards (the shard is selected by upper 16 bits of hash)
+#define HT_CONC_MAX_SHARDS 65536
+
+// Size of cache line, shards are padded by it to not share their lines
+#define HT_CONC_CACHE_LINE 64
+
+// Shard of the table
+typedef struct ht_conc_shard {
+  pthread_rwlock_t lock;            // lock of the shard
+  ht_dyn_table_t table;             // items of the shard
+  char padding[HT_CONC_CACHE_LINE]; // separation from the next shard
+} ht_conc_shard_t;
+
+// Thread-safe table
+typedef struct ht_conc_table {
+  ht_conc_shard_t *shards; // shard array
+  size_t shard_count;      // number of shards (power of two)
+} ht_conc_table_t;
+
+bool ht_conc_init(ht_conc_table_t *table, size_t shards);
+bool ht_conc_init_with(ht_conc_table_t *table, size_t shards, unsigned flags);
+bool ht_conc_contains(ht_conc_table_t *table, char *key);
+bool ht_conc_get(ht_conc_table_t *table, char *key, float *value);
+void ht_conc_insert(ht_conc_table_t *table, char *key, float value);
+void ht_conc_delete(ht_conc_table_t *table, char *key);
+void ht_conc_delete_all(ht_conc_table_t *table);
+void ht_conc_destroy(ht_conc_table_t *table);
+
+bool ht_conc_set_hash(ht_conc_table_t *table, ht_hash_fn_t hash,
+                      uint64_t seed);
+size_t ht_conc_count(ht_conc_table_t *table);
+
+#endif
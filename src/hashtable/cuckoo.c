@@ -0,0 +1,341 @@
+/*
+ * Bucketized cuckoo hash table
+ *
+ * Both buckets of a key are derived from its full 64-bit hash: the first one
+ * from the low bits, the second one by XORing the first index with a mix of
+ * the high bits (an odd number, so the buckets differ whenever there are at
+ * least two of them). Items store their full hashes, so moving an item to its
+ * other bucket needs no hashing.
+ *
+ * When both buckets of a new item are full, a random item of one of them is
+ * kicked out to its other bucket, which can kick out another item, and so on
+ * (random walk). If no free slot is found in HT_CUCKOO_MAX_KICKS moves, the
+ * item left without a slot waits in the stash. If the stash is full too, the
+ * table is doubled. If the item doesn't fit even the doubled table (more than
+ * 2 * HT_CUCKOO_WAYS + HT_CUCKOO_STASH keys with the same hash), the insertion
+ * fails instead of doubling the table over and over. Deleting an item from a
+ * bucket lets the stashed items return into the buckets.
+ */
+
+#include "cuckoo.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline uint64_t cuckoo_hash(ht_cuckoo_table_t *table, const char *key) {
+    return table->hash(key, strlen(key), table->seed);
+}
+
+static inline size_t cuckoo_first(ht_cuckoo_table_t *table, uint64_t hash) {
+    return (size_t) hash & (table->size - 1);
+}
+
+static inline size_t cuckoo_second(ht_cuckoo_table_t *table, uint64_t hash) {
+    uint64_t mix = ((hash >> 32) * 0xc6a4a7935bd1e995ULL) >> 32;
+
+    return (cuckoo_first(table, hash) ^ (size_t) (mix | 1)) & (table->size - 1);
+}
+
+/*
+ * Returns the bucket of the hash which isn't the given one.
+ */
+static inline size_t cuckoo_other(ht_cuckoo_table_t *table, uint64_t hash, size_t bucket) {
+    size_t first = cuckoo_first(table, hash);
+
+    return bucket == first ? cuckoo_second(table, hash) : first;
+}
+
+/*
+ * Returns a free slot of the bucket or NULL if the bucket is full.
+ */
+static inline ht_cuckoo_item_t *cuckoo_free_slot(ht_cuckoo_table_t *table, size_t bucket) {
+    for (int i = 0; i < HT_CUCKOO_WAYS; i++) {
+        if (table->buckets[bucket].slots[i].key == NULL) {
+            return &table->buckets[bucket].slots[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns a pseudorandom number (xorshift64).
+ */
+static inline uint64_t cuckoo_random(ht_cuckoo_table_t *table) {
+    table->random ^= table->random << 13;
+    table->random ^= table->random >> 7;
+    table->random ^= table->random << 17;
+
+    return table->random;
+}
+
+/*
+ * Finds the item with the key in its buckets and in the stash.
+ */
+static ht_cuckoo_item_t *cuckoo_find(ht_cuckoo_table_t *table, char *key, uint64_t hash) {
+    size_t buckets[2] = {cuckoo_first(table, hash), cuckoo_second(table, hash)};
+    for (int b = 0; b < 2; b++) {
+        for (int i = 0; i < HT_CUCKOO_WAYS; i++) {
+            ht_cuckoo_item_t *item = &table->buckets[buckets[b]].slots[i];
+            if (item->hash == hash && item->key != NULL && strcmp(item->key, key) == 0) {
+                return item;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < table->stashed; i++) {
+        if (table->stash[i].hash == hash && strcmp(table->stash[i].key, key) == 0) {
+            return &table->stash[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Places the item into one of its buckets, moving other items if needed.
+ *
+ * Returns false if no free slot has been found; the item is then replaced by
+ * the item left without a slot (it may be a different one).
+ */
+static bool cuckoo_place(ht_cuckoo_table_t *table, ht_cuckoo_item_t *item) {
+    ht_cuckoo_item_t *slot;
+    size_t first = cuckoo_first(table, item->hash);
+    size_t second = cuckoo_second(table, item->hash);
+    if ((slot = cuckoo_free_slot(table, first)) != NULL || (slot = cuckoo_free_slot(table, second)) != NULL) {
+        *slot = *item;
+        return true;
+    }
+
+    size_t bucket = cuckoo_random(table) & 1 ? second : first;
+    for (int kick = 0; kick < HT_CUCKOO_MAX_KICKS; kick++) {
+        // Kicked out item continues to its other bucket
+        ht_cuckoo_item_t *victim = &table->buckets[bucket].slots[cuckoo_random(table) % HT_CUCKOO_WAYS];
+        ht_cuckoo_item_t kicked = *victim;
+        *victim = *item;
+        *item = kicked;
+
+        bucket = cuckoo_other(table, item->hash, bucket);
+        if ((slot = cuckoo_free_slot(table, bucket)) != NULL) {
+            *slot = *item;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Moves all the items (and the extra item if it isn't NULL) into a new bucket
+ * array of the given size. Returns false if they don't fit it even with the
+ * stash or if there is not enough memory (table isn't changed then).
+ */
+static bool cuckoo_resize(ht_cuckoo_table_t *table, size_t size, ht_cuckoo_item_t *extra) {
+    ht_cuckoo_bucket_t *old_buckets = table->buckets;
+    size_t old_size = table->size;
+    ht_cuckoo_item_t old_stash[HT_CUCKOO_STASH];
+    size_t old_stashed = table->stashed;
+    memcpy(old_stash, table->stash, sizeof(old_stash));
+
+    ht_cuckoo_bucket_t *buckets;
+    if ((buckets = calloc(size, sizeof(ht_cuckoo_bucket_t))) == NULL) {
+        return false;
+    }
+
+    table->buckets = buckets;
+    table->size = size;
+    table->stashed = 0;
+
+    // Old items are copied, so the old arrays stay untouched if they don't fit
+    size_t old_items = old_size * HT_CUCKOO_WAYS + old_stashed;
+    for (size_t i = 0; i < old_items + (extra != NULL); i++) {
+        ht_cuckoo_item_t item;
+        if (i < old_size * HT_CUCKOO_WAYS) {
+            item = old_buckets[i / HT_CUCKOO_WAYS].slots[i % HT_CUCKOO_WAYS];
+        } else if (i < old_items) {
+            item = old_stash[i - old_size * HT_CUCKOO_WAYS];
+        } else {
+            item = *extra;
+        }
+        if (item.key == NULL || cuckoo_place(table, &item)) {
+            continue;
+        }
+
+        if (table->stashed == HT_CUCKOO_STASH) {
+            free(buckets);
+            table->buckets = old_buckets;
+            table->size = old_size;
+            table->stashed = old_stashed;
+            memcpy(table->stash, old_stash, sizeof(old_stash));
+            return false;
+        }
+
+        table->stash[table->stashed++] = item;
+    }
+
+    free(old_buckets);
+    return true;
+}
+
+/*
+ * Moves the stashed items whose buckets have a free slot back to the buckets.
+ */
+static void cuckoo_unstash(ht_cuckoo_table_t *table) {
+    for (size_t i = 0; i < table->stashed;) {
+        ht_cuckoo_item_t *slot;
+        uint64_t hash = table->stash[i].hash;
+        if ((slot = cuckoo_free_slot(table, cuckoo_first(table, hash))) != NULL ||
+            (slot = cuckoo_free_slot(table, cuckoo_second(table, hash))) != NULL) {
+            *slot = table->stash[i];
+            table->stash[i] = table->stash[--table->stashed];
+        } else {
+            i++;
+        }
+    }
+}
+
+/*
+ * Initialization of the table — call it before the first usage of the table.
+ * No memory is allocated until the first item is inserted.
+ */
+void ht_cuckoo_init(ht_cuckoo_table_t *table) {
+    table->buckets = NULL;
+    table->size = 0;
+    table->count = 0;
+    table->stashed = 0;
+    table->random = 0x2545f4914f6cdd1dULL;
+    table->hash = ht_hash_wy;
+    table->seed = ht_hash_random_seed();
+}
+
+/*
+ * Changes hash function and seed of the table.
+ *
+ * It can be done only while the table is empty. Returns true if the function
+ * has been changed.
+ */
+bool ht_cuckoo_set_hash(ht_cuckoo_table_t *table, ht_hash_fn_t hash, uint64_t seed) {
+    if (table->count != 0) {
+        return false;
+    }
+
+    table->hash = hash;
+    table->seed = seed;
+
+    return true;
+}
+
+/*
+ * Searching for an item in the table.
+ *
+ * Returns pointer to the found item or NULL if there is no item with the key.
+ * At most two buckets and the stash are searched. The pointer is valid until
+ * the next insertion or deletion.
+ */
+ht_cuckoo_item_t *ht_cuckoo_search(ht_cuckoo_table_t *table, char *key) {
+    if (table->size == 0) {
+        return NULL;
+    }
+
+    return cuckoo_find(table, key, cuckoo_hash(table, key));
+}
+
+/*
+ * Inserting a new item into the table.
+ *
+ * If there already is an item with the key, only its value is replaced.
+ * Returns false if the item couldn't be inserted: there is not enough memory,
+ * or too many keys share the buckets of the key (when even the doubled table
+ * doesn't fit them, the table isn't doubled again).
+ */
+bool ht_cuckoo_insert(ht_cuckoo_table_t *table, char *key, float value) {
+    uint64_t hash = cuckoo_hash(table, key);
+    if (table->size != 0) {
+        ht_cuckoo_item_t *item = cuckoo_find(table, key, hash);
+        if (item != NULL) {
+            // Item is already in the table --> only change its value
+            item->value = value;
+
+            return true;
+        }
+    }
+
+    if ((table->count + 1) * 100 > table->size * HT_CUCKOO_WAYS * HT_CUCKOO_MAX_LOAD) {
+        // The item may still fit the current buckets if the growth fails
+        if (!cuckoo_resize(table, table->size == 0 ? HT_CUCKOO_INITIAL_SIZE : table->size * 2, NULL) &&
+            table->size == 0) {
+            return false;
+        }
+    }
+
+    ht_cuckoo_item_t item = {key, value, hash};
+    if (!cuckoo_place(table, &item)) {
+        if (table->stashed < HT_CUCKOO_STASH) {
+            table->stash[table->stashed++] = item;
+        } else if (!cuckoo_resize(table, table->size * 2, &item)) {
+            // The new item gives its slot back to the item without one (if they differ)
+            ht_cuckoo_item_t *slot = cuckoo_find(table, key, hash);
+            if (slot != NULL) {
+                *slot = item;
+            }
+            return false;
+        }
+    }
+
+    table->count++;
+    return true;
+}
+
+/*
+ * Getting value of the item from the table.
+ *
+ * Returns pointer to the value of the item or NULL if there is no item with the
+ * key.
+ */
+float *ht_cuckoo_get(ht_cuckoo_table_t *table, char *key) {
+    ht_cuckoo_item_t *item;
+    if ((item = ht_cuckoo_search(table, key)) != NULL) {
+        return &item->value;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Deleting an item from the table.
+ *
+ * If there is no item with the key, nothing happens.
+ */
+void ht_cuckoo_delete(ht_cuckoo_table_t *table, char *key) {
+    if (table->size == 0) {
+        return;
+    }
+
+    ht_cuckoo_item_t *item = cuckoo_find(table, key, cuckoo_hash(table, key));
+    if (item == NULL) {
+        return;
+    }
+
+    if (item >= table->stash && item < table->stash + HT_CUCKOO_STASH) {
+        *item = table->stash[--table->stashed];
+    } else {
+        item->key = NULL;
+        cuckoo_unstash(table);
+    }
+
+    table->count--;
+}
+
+/*
+ * Deleting all items from the table.
+ *
+ * All allocated resources are released and the table is in the same state as
+ * after the initialization (hash function and seed are kept).
+ */
+void ht_cuckoo_delete_all(ht_cuckoo_table_t *table) {
+    free(table->buckets);
+
+    table->buckets = NULL;
+    table->size = 0;
+    table->count = 0;
+    table->stashed = 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Header file for the bucketized cuckoo hash table.
+ *
+ * Every key can be stored only in one of two buckets of HT_CUCKOO_WAYS slots
+ * (or in a small stash), so a lookup compares at most
+ * 2 * HT_CUCKOO_WAYS + HT_CUCKOO_STASH keys, however the keys collide. The
+ * insertion makes room by moving items to their other buckets.
+ */
+
+#ifndef IAL_HASHTABLE_CUCKOO_H
+#define IAL_HASHTABLE_CUCKOO_H
+
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of slots in a bucket
+#define HT_CUCKOO_WAYS 4
+
+// Number of buckets allocated by the first insertion (power of two)
+#define HT_CUCKOO_INITIAL_SIZE 4
+
+// Number of items which can wait in the stash when the insertion fails
+#define HT_CUCKOO_STASH 4
+
+// Maximum number of items moved by one insertion before it uses the stash
+#define HT_CUCKOO_MAX_KICKS 256
+
+// Maximum load factor (in percents) the table can reach before it grows
+#define HT_CUCKOO_MAX_LOAD 90
+
+// Item of the table, unused slots have NULL key
+typedef struct ht_cuckoo_item {
+  char *key;     // key of the item
+  float value;   // value of the item
+  uint64_t hash; // full hash of the key (both buckets are derived from it)
+} ht_cuckoo_item_t;
+
+// Bucket of the table
+typedef struct ht_cuckoo_bucket {
+  ht_cuckoo_item_t slots[HT_CUCKOO_WAYS]; // items of the bucket
+} ht_cuckoo_bucket_t;
+
+// Cuckoo table
+typedef struct ht_cuckoo_table {
+  ht_cuckoo_bucket_t *buckets;             // buckets (count is a power of two)
+  size_t size;                             // number of buckets
+  size_t count;                            // number of stored items
+  ht_cuckoo_item_t stash[HT_CUCKOO_STASH]; // items which didn't fit the buckets
+  size_t stashed;                          // number of items in the stash
+  uint64_t random;                         // state of the choice of moved items
+  ht_hash_fn_t hash;                       // hash function
+  uint64_t seed;                           // seed of the hash function
+} ht_cuckoo_table_t;
+
+void ht_cuckoo_init(ht_cuckoo_table_t *table);
+ht_cuckoo_item_t *ht_cuckoo_search(ht_cuckoo_table_t *table, char *key);
+bool ht_cuckoo_insert(ht_cuckoo_table_t *table, char *key, float value);
+float *ht_cuckoo_get(ht_cuckoo_table_t *table, char *key);
+void ht_cuckoo_delete(ht_cuckoo_table_t *table, char *key);
+void ht_cuckoo_delete_all(ht_cuckoo_table_t *table);
+
+bool ht_cuckoo_set_hash(ht_cuckoo_table_t *table, ht_hash_fn_t hash,
+                        uint64_t seed);
+
+#endif
@@ -0,0 +1,804 @@
+/*
+ * Dynamically resizable hash table
+ *
+ * Table with explicitly chained synonyms whose bucket array grows when the load
+ * factor exceeds HT_DYN_MAX_LOAD. Growing only allocates a new (twice bigger)
+ * array; items are migrated from the old one by HT_DYN_REHASH_STEP buckets with
+ * each modifying operation, so no single call has to rehash the whole table.
+ *
+ * While the migration is in progress, an item lives in the old array if its old
+ * bucket hasn't been migrated yet, otherwise it lives in the new array.
+ *
+ * With HT_DYN_SLAB flag, items are taken from the table's slab allocator
+ * instead of malloc, so deleting all the items means releasing a few slabs.
+ *
+ * With HT_DYN_OWN_KEYS flag, the table stores copies of the keys: short keys
+ * directly in the (bigger) items, long keys in the table's string arena (copies
+ * of deleted keys are reused there, so the arena doesn't grow with churn). Such
+ * table can also intern strings (ht_dyn_intern): all equal strings get the same
+ * canonical pointer. Tables with HT_DYN_INTERNED flag accept only canonical
+ * pointers as keys, so they hash and compare the pointers, not the strings.
+ *
+ * With HT_DYN_BLOOM flag, lookups consult a blocked Bloom filter of the stored
+ * keys before the bucket, so most lookups of missing keys don't touch the
+ * buckets and items at all. Deleted keys stay in the filter (they only make it
+ * less effective) until there are more of them than the stored keys; then the
+ * filter is filled again by the next modifying operation. The same happens
+ * when more keys are inserted than the filter has been sized for.
+ */
+
+#include "dyn_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __GNUC__
+#define DYN_PREFETCH(ADDRESS) __builtin_prefetch(ADDRESS)
+#else
+#define DYN_PREFETCH(ADDRESS)
+#endif
+
+/*
+ * Computes the full (not reduced) hash of the key with the table's function.
+ */
+static inline uint64_t dyn_hash(ht_dyn_table_t *table, const char *key) {
+    if (table->flags & HT_DYN_INTERNED) {
+        // Equal interned keys have equal pointers
+        return table->hash((const char *) &key, sizeof(key), table->seed);
+    }
+
+    return table->hash(key, strlen(key), table->seed);
+}
+
+/*
+ * Returns true if the item has the key with the given hash.
+ */
+static inline bool dyn_has_key(ht_dyn_table_t *table, ht_item_t *item, const char *key, uint64_t hash) {
+    // Keys with different hashes can't be equal, so strcmp is needed only for the same hashes
+    if (item->hash != hash) {
+        return false;
+    }
+
+    // The same pointer is the same key (canonical pointers of interned keys are always the same)
+    if (item->key == key) {
+        return true;
+    }
+
+    return !(table->flags & HT_DYN_INTERNED) && strcmp(item->key, key) == 0;
+}
+
+/*
+ * Allocates memory for a new item.
+ */
+static inline ht_item_t *dyn_alloc_item(ht_dyn_table_t *table) {
+    ht_item_t *item;
+    if (table->flags & HT_DYN_SLAB) {
+        item = ht_slab_alloc(&table->pool);
+    } else {
+        item = malloc(table->pool.item_size);
+    }
+
+    if (item != NULL) {
+        table->counters.allocations++;
+    }
+
+    return item;
+}
+
+/*
+ * Stores a copy of the key for the item. Returns the copy or NULL if there is
+ * not enough memory.
+ */
+static char *dyn_copy_key(ht_dyn_table_t *table, ht_item_t *item, const char *key) {
+    size_t length = strlen(key);
+    if (length > HT_DYN_INLINE_KEY) {
+        return ht_arena_strdup(&table->keys, key, length);
+    }
+
+    // Short key fits into the item
+    char *copy = ((ht_dyn_owned_item_t *) item)->inline_key;
+    memcpy(copy, key, length + 1);
+
+    return copy;
+}
+
+/*
+ * Releases the copy of the item's key if it's stored in the string arena.
+ */
+static inline void dyn_free_key(ht_dyn_table_t *table, ht_item_t *item) {
+    if ((table->flags & HT_DYN_OWN_KEYS) && item->key != ((ht_dyn_owned_item_t *) item)->inline_key) {
+        ht_arena_free(&table->keys, item->key, strlen(item->key));
+    }
+}
+
+/*
+ * Releases memory of the deleted item.
+ */
+static inline void dyn_free_item(ht_dyn_table_t *table, ht_item_t *item) {
+    table->counters.frees++;
+    if (table->flags & HT_DYN_SLAB) {
+        ht_slab_free(&table->pool, item);
+    } else {
+        free(item);
+    }
+}
+
+/*
+ * Returns the place where the list of synonyms for the given hash starts.
+ */
+static ht_item_t **dyn_bucket(ht_dyn_table_t *table, uint64_t hash) {
+    if (table->old_buckets != NULL) {
+        size_t old_index = hash & (table->old_size - 1);
+        if (old_index >= table->rehash_index) {
+            // Old bucket hasn't been migrated yet --> the item is still there
+            return &table->old_buckets[old_index];
+        }
+    }
+
+    return &table->buckets[hash & (table->size - 1)];
+}
+
+/*
+ * Moves up to HT_DYN_REHASH_STEP buckets from the old array to the new one.
+ * The old array is released when the last bucket is migrated.
+ */
+static void dyn_rehash_step(ht_dyn_table_t *table) {
+    if (table->old_buckets == NULL) {
+        return;
+    }
+
+    for (int step = 0; step < HT_DYN_REHASH_STEP && table->rehash_index < table->old_size; step++) {
+        ht_item_t *item = table->old_buckets[table->rehash_index];
+        while (item != NULL) {
+            ht_item_t *next = item->next;
+
+            // Prepend item to its list of synonyms in the new array
+            // (the stored hash is used, so keys don't need to be hashed again)
+            ht_item_t **bucket = &table->buckets[item->hash & (table->size - 1)];
+            item->next = *bucket;
+            *bucket = item;
+
+            item = next;
+        }
+
+        table->old_buckets[table->rehash_index++] = NULL;
+    }
+
+    if (table->rehash_index == table->old_size) {
+        // Migration is complete
+        free(table->old_buckets);
+        table->old_buckets = NULL;
+        table->old_size = 0;
+        table->rehash_index = 0;
+    }
+}
+
+/*
+ * Starts growing the table when the load factor is too high. The table isn't
+ * grown while a previous migration is still in progress.
+ */
+static void dyn_grow_if_needed(ht_dyn_table_t *table) {
+    if (table->old_buckets != NULL || table->count * 100 <= table->size * HT_DYN_MAX_LOAD) {
+        return;
+    }
+
+    ht_item_t **new_buckets;
+    if ((new_buckets = calloc(table->size * 2, sizeof(ht_item_t *))) == NULL) {
+        // Table can work with longer lists of synonyms, let's try it next time
+        return;
+    }
+
+    table->old_buckets = table->buckets;
+    table->old_size = table->size;
+    table->rehash_index = 0;
+    table->buckets = new_buckets;
+    table->size *= 2;
+    table->counters.grows++;
+}
+
+/*
+ * Fills the filter again with the keys of all the stored items. The filter is
+ * sized for at least the current number of keys (its size is rounded up to a
+ * power of two, which leaves room for more keys).
+ */
+static void dyn_bloom_rebuild(ht_dyn_table_t *table) {
+    size_t capacity = table->count + 1 > HT_DYN_INITIAL_SIZE ? table->count + 1 : HT_DYN_INITIAL_SIZE;
+    if (!ht_bloom_reset(&table->bloom, capacity)) {
+        return;
+    }
+
+    ht_item_t **arrays[] = {table->old_buckets, table->buckets};
+    size_t firsts[] = {table->rehash_index, 0};
+    size_t sizes[] = {table->old_size, table->size};
+    for (int i = 0; i < 2; i++) {
+        for (size_t j = firsts[i]; arrays[i] != NULL && j < sizes[i]; j++) {
+            for (ht_item_t *item = arrays[i][j]; item != NULL; item = item->next) {
+                ht_bloom_add(&table->bloom, item->hash);
+            }
+        }
+    }
+}
+
+/*
+ * Rebuilds the filter if it is too full or if most of its keys are deleted.
+ */
+static inline void dyn_bloom_maintain(ht_dyn_table_t *table) {
+    if (!(table->flags & HT_DYN_BLOOM) || (table->bloom.blocks == NULL && table->bloom.capacity == SIZE_MAX)) {
+        // No filter, or its reset has failed (it isn't tried again)
+        return;
+    }
+
+    // Every added key is either stored or deleted (updates don't add keys)
+    size_t deleted = table->bloom.added - table->count;
+    if (table->bloom.added > table->bloom.capacity || deleted > table->count) {
+        dyn_bloom_rebuild(table);
+    }
+}
+
+/*
+ * Counts the lookup into the statistics (only if they're enabled, counters of
+ * lookups can't be updated by concurrent readers).
+ */
+static inline void dyn_count_lookup(ht_dyn_table_t *table, bool found, size_t probes) {
+    if (table->flags & HT_DYN_STATS) {
+        if (found) {
+            table->counters.hits++;
+        } else {
+            table->counters.misses++;
+        }
+        table->counters.probes += probes;
+    }
+}
+
+/*
+ * Puts the table into the empty state (hash function and seed are kept).
+ */
+static void dyn_reset(ht_dyn_table_t *table) {
+    table->buckets = NULL;
+    table->size = 0;
+    table->old_buckets = NULL;
+    table->old_size = 0;
+    table->rehash_index = 0;
+    table->count = 0;
+}
+
+/*
+ * Initialization of the table — call it before the first usage of the table.
+ * No memory is allocated until the first item is inserted.
+ *
+ * Every table gets its own random seed, so the keys colliding in one table
+ * (and in one process) can't be prepared in advance.
+ */
+void ht_dyn_init(ht_dyn_table_t *table) {
+    ht_dyn_init_with(table, 0);
+}
+
+/*
+ * Initialization of the table with the given HT_DYN_* flags.
+ */
+void ht_dyn_init_with(ht_dyn_table_t *table, unsigned flags) {
+    if (flags & HT_DYN_INTERNED) {
+        // Copies would have different pointers than the canonical keys
+        flags &= ~(unsigned) HT_DYN_OWN_KEYS;
+    }
+
+    dyn_reset(table);
+    table->hash = ht_hash_wy;
+    table->seed = ht_hash_random_seed();
+    table->flags = flags;
+    memset(&table->counters, 0, sizeof(table->counters));
+    ht_slab_init(&table->pool, flags & HT_DYN_OWN_KEYS ? sizeof(ht_dyn_owned_item_t) : sizeof(ht_item_t));
+    ht_arena_init(&table->keys);
+    ht_bloom_init(&table->bloom);
+}
+
+/*
+ * Changes hash function and seed of the table.
+ *
+ * It can be done only while the table is empty (the items would have to be
+ * rehashed otherwise). Returns true if the function has been changed.
+ */
+bool ht_dyn_set_hash(ht_dyn_table_t *table, ht_hash_fn_t hash, uint64_t seed) {
+    if (table->count != 0) {
+        return false;
+    }
+
+    table->hash = hash;
+    table->seed = seed;
+
+    return true;
+}
+
+/*
+ * Interning of the key.
+ *
+ * Returns the canonical pointer of the key: the key stored in the table. If
+ * there is no such key, it is inserted (with value 0). Tables with
+ * HT_DYN_OWN_KEYS flag store copies, so the canonical pointer is valid until
+ * the key is deleted from the table, even if the given key is changed. Returns
+ * NULL if there is not enough memory.
+ */
+char *ht_dyn_intern(ht_dyn_table_t *table, char *key) {
+    ht_item_t *item;
+    if ((item = ht_dyn_search(table, key)) == NULL) {
+        ht_dyn_insert(table, key, 0);
+        item = ht_dyn_search(table, key);
+    }
+
+    return item != NULL ? item->key : NULL;
+}
+
+/*
+ * Searching for an item in the table.
+ *
+ * Returns pointer to the found item or NULL if there is no item with the key.
+ */
+ht_item_t *ht_dyn_search(ht_dyn_table_t *table, char *key) {
+    return ht_dyn_search_hashed(table, key, dyn_hash(table, key));
+}
+
+/*
+ * Searching for an item whose key has the given (ht_dyn_hash) hash.
+ */
+ht_item_t *ht_dyn_search_hashed(ht_dyn_table_t *table, char *key, uint64_t hash) {
+    if (table->size == 0) {
+        // No item has been inserted yet
+        dyn_count_lookup(table, false, 0);
+        return NULL;
+    }
+
+    if ((table->flags & HT_DYN_BLOOM) && !ht_bloom_may_contain(&table->bloom, hash)) {
+        // Key has surely never been inserted (since the last rebuild of the filter)
+        dyn_count_lookup(table, false, 0);
+        if (table->flags & HT_DYN_STATS) {
+            table->counters.filtered++;
+        }
+        return NULL;
+    }
+
+    ht_item_t *found = *dyn_bucket(table, hash);
+    size_t probes = 0;
+
+    for (; found != NULL; found = found->next) {
+        probes++;
+        if (dyn_has_key(table, found, key, hash)) {
+            break;
+        }
+    }
+
+    dyn_count_lookup(table, found != NULL, probes);
+
+    return found;
+}
+
+/*
+ * Inserting a new item into the table.
+ *
+ * If there already is an item with the key, only its value is replaced.
+ * New item is inserted at the beginning of the list of synonyms.
+ */
+void ht_dyn_insert(ht_dyn_table_t *table, char *key, float value) {
+    ht_dyn_insert_hashed(table, key, dyn_hash(table, key), value);
+}
+
+/*
+ * Inserts the item into the list of synonyms starting at the bucket, or only
+ * replaces the value if the key is already there. Returns false if there is
+ * not enough memory.
+ */
+static bool dyn_put(ht_dyn_table_t *table, ht_item_t **bucket, char *key, uint64_t hash, float value) {
+    ht_item_t *item = *bucket;
+    while (item != NULL && !dyn_has_key(table, item, key, hash)) {
+        item = item->next;
+    }
+
+    if (item != NULL) {
+        // Item is already in the table --> only change its value
+        item->value = value;
+        table->counters.updates++;
+
+        return true;
+    }
+
+    if ((item = dyn_alloc_item(table)) == NULL) {
+        return false;
+    }
+
+    if (!(table->flags & HT_DYN_OWN_KEYS)) {
+        item->key = key;
+    } else if ((item->key = dyn_copy_key(table, item, key)) == NULL) {
+        dyn_free_item(table, item);
+        return false;
+    }
+
+    item->value = value;
+    item->next = *bucket;
+    item->hash = hash;
+    *bucket = item;
+
+    table->count++;
+    table->counters.inserts++;
+    if (table->flags & HT_DYN_BLOOM) {
+        ht_bloom_add(&table->bloom, hash);
+    }
+
+    return true;
+}
+
+/*
+ * Inserting an item whose key has the given (ht_dyn_hash) hash.
+ */
+void ht_dyn_insert_hashed(ht_dyn_table_t *table, char *key, uint64_t hash, float value) {
+    if (table->size == 0) {
+        // First insertion --> allocate buckets
+        if ((table->buckets = calloc(HT_DYN_INITIAL_SIZE, sizeof(ht_item_t *))) == NULL) {
+            return;
+        }
+        table->size = HT_DYN_INITIAL_SIZE;
+    }
+
+    if (!dyn_put(table, dyn_bucket(table, hash), key, hash, value)) {
+        return;
+    }
+
+    dyn_rehash_step(table);
+    dyn_grow_if_needed(table);
+    dyn_bloom_maintain(table);
+}
+
+/*
+ * Inserting many items at once.
+ *
+ * The result is the same as inserting the items one by one (a later item with
+ * an already inserted key replaces its value), but every key is hashed only
+ * once and the bucket array is grown to its final size before the insertion,
+ * so no items are migrated later. New items are partitioned by their buckets
+ * (counting sort of the bucket indexes) and each list of synonyms is built at
+ * once, so items of one list are allocated next to each other.
+ *
+ * Returns false if there is not enough memory: either nothing is inserted
+ * (temporary arrays can't be allocated), or only a part of the items.
+ */
+bool ht_dyn_insert_bulk(ht_dyn_table_t *table, const ht_item_t items[], size_t count) {
+    if (count == 0) {
+        return true;
+    }
+
+    // Smallest power of two keeping the load factor under HT_DYN_MAX_LOAD
+    size_t size = table->size != 0 ? table->size : HT_DYN_INITIAL_SIZE;
+    while ((table->count + count) * 100 > size * HT_DYN_MAX_LOAD) {
+        size *= 2;
+    }
+
+    uint64_t *hashes = malloc(count * sizeof(uint64_t));
+    size_t *order = malloc(count * sizeof(size_t));
+    size_t *starts = calloc(size + 1, sizeof(size_t));
+    ht_item_t **buckets = size != table->size ? calloc(size, sizeof(ht_item_t *)) : NULL;
+    if (hashes == NULL || order == NULL || starts == NULL || (buckets == NULL && size != table->size)) {
+        free(hashes);
+        free(order);
+        free(starts);
+        free(buckets);
+        return false;
+    }
+
+    // Finish the migration, then move the items into the array of the final size
+    while (table->old_buckets != NULL) {
+        dyn_rehash_step(table);
+    }
+    if (buckets != NULL) {
+        for (size_t i = 0; i < table->size; i++) {
+            ht_item_t *item = table->buckets[i];
+            while (item != NULL) {
+                ht_item_t *next = item->next;
+                ht_item_t **bucket = &buckets[item->hash & (size - 1)];
+                item->next = *bucket;
+                *bucket = item;
+                item = next;
+            }
+        }
+
+        free(table->buckets);
+        table->buckets = buckets;
+        if (table->size != 0) {
+            table->counters.grows++;
+        }
+        table->size = size;
+    }
+
+    // Counting sort of the items by their buckets (stable, so later duplicates win)
+    for (size_t i = 0; i < count; i++) {
+        hashes[i] = dyn_hash(table, items[i].key);
+        starts[(hashes[i] & (size - 1)) + 1]++;
+    }
+    for (size_t i = 0; i < size; i++) {
+        starts[i + 1] += starts[i];
+    }
+    for (size_t i = 0; i < count; i++) {
+        order[starts[hashes[i] & (size - 1)]++] = i;
+    }
+
+    bool inserted = true;
+    for (size_t i = 0; i < count && inserted; i++) {
+        size_t index = order[i];
+        ht_item_t **bucket = &table->buckets[hashes[index] & (size - 1)];
+        inserted = dyn_put(table, bucket, items[index].key, hashes[index], items[index].value);
+    }
+    dyn_bloom_maintain(table);
+
+    free(hashes);
+    free(order);
+    free(starts);
+
+    return inserted;
+}
+
+/*
+ * Getting value of the item from the table.
+ *
+ * Returns pointer to the value of the item or NULL if there is no item with the
+ * key.
+ */
+float *ht_dyn_get(ht_dyn_table_t *table, char *key) {
+    ht_item_t *item;
+    if ((item = ht_dyn_search(table, key)) != NULL) {
+        return &item->value;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Getting values of many items at once.
+ *
+ * For every key, pointer to the value of the item (or NULL if there is no item
+ * with the key) is stored at the same index of values. Lookups are processed
+ * by HT_DYN_BATCH keys: all their buckets are prefetched first, then the lists
+ * of synonyms are walked in turns, one item of each list per round, with the
+ * next items prefetched. So the cache misses of different keys overlap instead
+ * of waiting for each other.
+ */
+void ht_dyn_get_many(ht_dyn_table_t *table, char *keys[], size_t count, float *values[]) {
+    if (table->size == 0) {
+        for (size_t i = 0; i < count; i++) {
+            values[i] = NULL;
+            dyn_count_lookup(table, false, 0);
+        }
+
+        return;
+    }
+
+    size_t probes = 0;
+    ht_item_t *filtered = NULL;
+    for (size_t start = 0; start < count; start += HT_DYN_BATCH) {
+        size_t batch = count - start < HT_DYN_BATCH ? count - start : HT_DYN_BATCH;
+        uint64_t hashes[HT_DYN_BATCH];
+        ht_item_t **buckets[HT_DYN_BATCH];
+        ht_item_t *items[HT_DYN_BATCH];
+
+        // Hash all the keys and prefetch their buckets
+        for (size_t i = 0; i < batch; i++) {
+            values[start + i] = NULL;
+            hashes[i] = dyn_hash(table, keys[start + i]);
+            if ((table->flags & HT_DYN_BLOOM) && !ht_bloom_may_contain(&table->bloom, hashes[i])) {
+                // Key rejected by the filter gets an empty list
+                buckets[i] = &filtered;
+                if (table->flags & HT_DYN_STATS) {
+                    table->counters.filtered++;
+                }
+                continue;
+            }
+            buckets[i] = dyn_bucket(table, hashes[i]);
+            DYN_PREFETCH(buckets[i]);
+        }
+
+        // Load heads of the lists of synonyms (buckets should be in cache now)
+        for (size_t i = 0; i < batch; i++) {
+            items[i] = *buckets[i];
+            DYN_PREFETCH(items[i]);
+        }
+
+        // Walk all the lists by one item per round until every key is resolved
+        size_t active = batch;
+        while (active > 0) {
+            active = 0;
+            for (size_t i = 0; i < batch; i++) {
+                ht_item_t *item = items[i];
+                if (item == NULL) {
+                    continue;
+                }
+
+                probes++;
+                if (dyn_has_key(table, item, keys[start + i], hashes[i])) {
+                    values[start + i] = &item->value;
+                    items[i] = NULL;
+                } else {
+                    items[i] = item->next;
+                    DYN_PREFETCH(items[i]);
+                    active++;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < batch; i++) {
+            dyn_count_lookup(table, values[start + i] != NULL, 0);
+        }
+    }
+
+    if (table->flags & HT_DYN_STATS) {
+        table->counters.probes += probes;
+    }
+}
+
+/*
+ * Deleting an item from the table.
+ *
+ * All resources allocated for the item are released. If there is no item with
+ * the key, nothing is deleted (but the migration of buckets still continues).
+ * Copy of a long key is released to the string arena for the following keys.
+ */
+void ht_dyn_delete(ht_dyn_table_t *table, char *key) {
+    ht_dyn_delete_hashed(table, key, dyn_hash(table, key));
+}
+
+/*
+ * Deleting an item whose key has the given (ht_dyn_hash) hash.
+ */
+void ht_dyn_delete_hashed(ht_dyn_table_t *table, char *key, uint64_t hash) {
+    if (table->size == 0) {
+        return;
+    }
+
+    // Find pointer to the item, so it can be directly unlinked
+    ht_item_t **ptr_to_item = dyn_bucket(table, hash);
+    while (*ptr_to_item != NULL && !dyn_has_key(table, *ptr_to_item, key, hash)) {
+        ptr_to_item = &(*ptr_to_item)->next;
+    }
+
+    if (*ptr_to_item != NULL) {
+        ht_item_t *item = *ptr_to_item;
+        *ptr_to_item = item->next;
+        dyn_free_key(table, item);
+        dyn_free_item(table, item);
+
+        table->count--;
+        table->counters.deletes++;
+    }
+
+    dyn_rehash_step(table);
+    dyn_bloom_maintain(table);
+}
+
+/*
+ * Deleting all items from the table.
+ *
+ * All allocated resources are released and the table is in the same state as
+ * after the initialization.
+ */
+void ht_dyn_delete_all(ht_dyn_table_t *table) {
+    ht_item_t **arrays[] = {table->old_buckets, table->buckets};
+    size_t sizes[] = {table->old_size, table->size};
+
+    for (int i = 0; i < 2; i++) {
+        if (arrays[i] == NULL) {
+            continue;
+        }
+
+        // Items from slabs are released with their slabs, lists don't need to be walked
+        for (size_t j = 0; j < sizes[i] && !(table->flags & HT_DYN_SLAB); j++) {
+            ht_item_t *item = arrays[i][j];
+            while (item != NULL) {
+                ht_item_t *next = item->next;
+                free(item);
+                item = next;
+            }
+        }
+
+        free(arrays[i]);
+    }
+
+    table->counters.deletes += table->count;
+    table->counters.frees += table->count;
+
+    ht_slab_release(&table->pool);
+    ht_arena_release(&table->keys);
+    ht_bloom_release(&table->bloom);
+    dyn_reset(table);
+}
+
+/*
+ * Returns full hash of the key as computed by the table. It can be computed
+ * once and passed to the *_hashed functions.
+ */
+uint64_t ht_dyn_hash(ht_dyn_table_t *table, char *key) {
+    return dyn_hash(table, key);
+}
+
+/*
+ * Returns current load factor (average number of items per bucket).
+ */
+double ht_dyn_load_factor(ht_dyn_table_t *table) {
+    if (table->size == 0) {
+        return 0.0;
+    }
+
+    return (double) table->count / (double) table->size;
+}
+
+/*
+ * Returns true if items are being migrated to a bigger bucket array.
+ */
+bool ht_dyn_rehashing(ht_dyn_table_t *table) {
+    return table->old_buckets != NULL;
+}
+
+/*
+ * Adds the list lengths of the bucket array into the statistics.
+ */
+static void dyn_stats_buckets(ht_dyn_stats_t *stats, ht_item_t **buckets, size_t size, size_t first) {
+    for (size_t i = first; i < size; i++) {
+        size_t length = 0;
+        for (ht_item_t *item = buckets[i]; item != NULL; item = item->next) {
+            length++;
+        }
+
+        stats->chains[length < HT_DYN_HISTOGRAM ? length : HT_DYN_HISTOGRAM]++;
+        if (length > stats->longest_chain) {
+            stats->longest_chain = length;
+        }
+    }
+}
+
+/*
+ * Fills statistics of the table.
+ *
+ * Counters are maintained by the operations, but the histogram of list
+ * lengths (chains[i] is the number of buckets with i items, the last one
+ * counts all the longer lists) and the allocated memory are computed by
+ * walking the whole table, so this shouldn't be called too often. Only
+ * buckets not migrated yet are counted from the old array.
+ */
+void ht_dyn_stats(ht_dyn_table_t *table, ht_dyn_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->count = table->count;
+    stats->load_factor = ht_dyn_load_factor(table);
+    stats->counters = table->counters;
+
+    size_t lookups = table->counters.hits + table->counters.misses;
+    if (lookups != 0) {
+        stats->average_probes = (double) table->counters.probes / (double) lookups;
+    }
+
+    if (table->old_buckets != NULL) {
+        stats->buckets += table->old_size - table->rehash_index;
+        dyn_stats_buckets(stats, table->old_buckets, table->old_size, table->rehash_index);
+    }
+    if (table->buckets != NULL) {
+        stats->buckets += table->size;
+        dyn_stats_buckets(stats, table->buckets, table->size, 0);
+    }
+
+    stats->memory = (table->size + table->old_size) * sizeof(ht_item_t *);
+    if (table->flags & HT_DYN_SLAB) {
+        for (ht_slab_t *slab = table->pool.slabs; slab != NULL; slab = slab->next) {
+            stats->memory += sizeof(ht_slab_t) + slab->capacity * table->pool.item_size;
+        }
+    } else {
+        stats->memory += table->count * table->pool.item_size;
+    }
+    for (ht_arena_chunk_t *chunk = table->keys.chunks; chunk != NULL; chunk = chunk->next) {
+        stats->memory += sizeof(ht_arena_chunk_t) + chunk->capacity;
+    }
+    for (ht_arena_long_t *block = table->keys.long_strings; block != NULL; block = block->next) {
+        stats->memory += sizeof(ht_arena_long_t) + strlen(block->data) + 1;
+    }
+    if (table->bloom.blocks != NULL) {
+        stats->memory += table->bloom.block_count * HT_BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+    }
+}
+
+/*
+ * Sets all the counters of the table to zero.
+ */
+void ht_dyn_reset_counters(ht_dyn_table_t *table) {
+    memset(&table->counters, 0, sizeof(table->counters));
+}
@@ -0,0 +1,122 @@
+/*
+ * Header file for the dynamically resizable hash table.
+ *
+ * Unlike ht_table_t with its fixed MAX_HT_SIZE buckets, the bucket array of
+ * ht_dyn_table_t is allocated on the heap and grows as items are inserted.
+ * Items aren't moved to the bigger array at once, the rehashing is spread over
+ * the following ht_dyn_insert/ht_dyn_delete calls instead.
+ */
+
+#ifndef IAL_HASHTABLE_DYN_TABLE_H
+#define IAL_HASHTABLE_DYN_TABLE_H
+
+#include "arena.h"
+#include "bloom.h"
+#include "hash.h"
+#include "hashtable.h"
+#include "slab.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Number of buckets allocated by the first insertion (power of two)
+#define HT_DYN_INITIAL_SIZE 16
+
+// Maximum load factor (in percents) the table can reach before it grows
+#define HT_DYN_MAX_LOAD 100
+
+// Number of old buckets migrated by each ht_dyn_insert/ht_dyn_delete call
+#define HT_DYN_REHASH_STEP 4
+
+// Maximum length of a key stored directly in the item (HT_DYN_OWN_KEYS only)
+#define HT_DYN_INLINE_KEY 15
+
+// Number of keys whose lookups are interleaved by ht_dyn_get_many
+#define HT_DYN_BATCH 16
+
+// Number of chain lengths counted separately by ht_dyn_stats
+#define HT_DYN_HISTOGRAM 8
+
+// Flags of ht_dyn_init_with (can be combined by |)
+#define HT_DYN_SLAB 0x1     // items are allocated from the table's slab allocator
+#define HT_DYN_OWN_KEYS 0x2 // keys are copied into the table
+#define HT_DYN_INTERNED 0x4 // keys are interned, they're compared by pointers
+#define HT_DYN_STATS 0x8    // lookups are counted (no concurrent readers then)
+#define HT_DYN_BLOOM 0x10   // misses are answered by a Bloom filter of the keys
+
+// Item of a table owning its keys, short keys are stored directly in it
+typedef struct ht_dyn_owned_item {
+  ht_item_t item;                         // item itself
+  char inline_key[HT_DYN_INLINE_KEY + 1]; // storage of a short key
+} ht_dyn_owned_item_t;
+
+// Counters updated by the operations of the table
+typedef struct ht_dyn_counters {
+  size_t hits;        // lookups which found the key (HT_DYN_STATS only)
+  size_t misses;      // lookups which didn't find it (HT_DYN_STATS only)
+  size_t probes;      // items compared by the lookups (HT_DYN_STATS only)
+  size_t filtered;    // misses answered by the filter (HT_DYN_STATS only)
+  size_t inserts;     // insertions of new items
+  size_t updates;     // insertions of already stored keys
+  size_t deletes;     // deleted items (including ht_dyn_delete_all)
+  size_t allocations; // allocated items
+  size_t frees;       // released items
+  size_t grows;       // started growths of the bucket array
+} ht_dyn_counters_t;
+
+// Statistics of the table (see ht_dyn_stats)
+typedef struct ht_dyn_stats {
+  size_t count;                        // number of stored items
+  size_t buckets;                      // number of buckets (both arrays)
+  double load_factor;                  // average number of items per bucket
+  size_t chains[HT_DYN_HISTOGRAM + 1]; // buckets by number of their items
+  size_t longest_chain;                // number of items of the longest list
+  double average_probes;               // items compared per lookup
+  size_t memory;                       // bytes allocated by the table
+  ht_dyn_counters_t counters;          // counters of the operations
+} ht_dyn_stats_t;
+
+// Dynamically resizable table
+typedef struct ht_dyn_table {
+  ht_item_t **buckets;        // bucket array (size is a power of two)
+  size_t size;                // number of buckets
+  ht_item_t **old_buckets;    // bucket array being migrated, NULL if none
+  size_t old_size;            // number of buckets of the old array
+  size_t rehash_index;        // first old bucket not migrated yet
+  size_t count;               // number of stored items
+  ht_hash_fn_t hash;          // hash function
+  uint64_t seed;              // seed of the hash function (random by default)
+  unsigned flags;             // HT_DYN_* flags given at the initialization
+  ht_slab_pool_t pool;        // allocator of items (HT_DYN_SLAB only)
+  ht_arena_t keys;            // copies of long keys (HT_DYN_OWN_KEYS only)
+  ht_bloom_t bloom;           // filter of the stored keys (HT_DYN_BLOOM only)
+  ht_dyn_counters_t counters; // counters of the operations
+} ht_dyn_table_t;
+
+void ht_dyn_init(ht_dyn_table_t *table);
+void ht_dyn_init_with(ht_dyn_table_t *table, unsigned flags);
+ht_item_t *ht_dyn_search(ht_dyn_table_t *table, char *key);
+void ht_dyn_insert(ht_dyn_table_t *table, char *key, float value);
+float *ht_dyn_get(ht_dyn_table_t *table, char *key);
+void ht_dyn_get_many(ht_dyn_table_t *table, char *keys[], size_t count,
+                     float *values[]);
+void ht_dyn_delete(ht_dyn_table_t *table, char *key);
+void ht_dyn_delete_all(ht_dyn_table_t *table);
+bool ht_dyn_insert_bulk(ht_dyn_table_t *table, const ht_item_t items[],
+                        size_t count);
+
+uint64_t ht_dyn_hash(ht_dyn_table_t *table, char *key);
+ht_item_t *ht_dyn_search_hashed(ht_dyn_table_t *table, char *key,
+                                uint64_t hash);
+void ht_dyn_insert_hashed(ht_dyn_table_t *table, char *key, uint64_t hash,
+                          float value);
+void ht_dyn_delete_hashed(ht_dyn_table_t *table, char *key, uint64_t hash);
+
+bool ht_dyn_set_hash(ht_dyn_table_t *table, ht_hash_fn_t hash, uint64_t seed);
+char *ht_dyn_intern(ht_dyn_table_t *table, char *key);
+
+double ht_dyn_load_factor(ht_dyn_table_t *table);
+bool ht_dyn_rehashing(ht_dyn_table_t *table);
+void ht_dyn_stats(ht_dyn_table_t *table, ht_dyn_stats_t *stats);
+void ht_dyn_reset_counters(ht_dyn_table_t *table);
+
+#endif
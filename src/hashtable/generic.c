@@ -0,0 +1,8 @@
+/*
+ * Instances of the generic hash tables declared in generic.h.
+ */
+
+#include "generic.h"
+
+HTDEF(uint64_t, float, u64, ht_generic_hash_int, HT_GENERIC_EQ)
+HTDEF(char *, float, str, ht_generic_hash_str, HT_GENERIC_STREQ)
@@ -0,0 +1,203 @@
+/*
+ * Header file for the generic hash tables.
+ *
+ * Tables are generated by macros for the given key type K and value type V
+ * (in the same way as the stacks of src/btree/iter/stack.h). Keys and values
+ * are stored directly in the items and the hash and equality of keys are
+ * given as macros (or inline functions), so they are inlined into the
+ * generated functions: integer keys are neither converted to strings nor
+ * compared by strcmp.
+ *
+ * HTDEC(K, V, TNAME) declares, for example for TNAME=u64:
+ *   Data types ht_u64_item_t and ht_u64_table_t
+ *   Functions void ht_u64_init(ht_u64_table_t *table)
+ *             ht_u64_item_t *ht_u64_search(ht_u64_table_t *table, K key)
+ *             void ht_u64_insert(ht_u64_table_t *table, K key, V value)
+ *             V *ht_u64_get(ht_u64_table_t *table, K key)
+ *             bool ht_u64_delete(ht_u64_table_t *table, K key)
+ *             void ht_u64_delete_all(ht_u64_table_t *table)
+ *
+ * HTDEF(K, V, TNAME, HASH, EQUAL) defines the functions in one translation
+ * unit. HASH(key, seed) returns uint64_t hash of the key, EQUAL(a, b) is true
+ * for equal keys. The items are chained in lists of synonyms like in
+ * ht_dyn_table_t, the bucket array is doubled (at once) when the load factor
+ * exceeds HT_GENERIC_MAX_LOAD.
+ */
+
+#ifndef IAL_HASHTABLE_GENERIC_H
+#define IAL_HASHTABLE_GENERIC_H
+
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of buckets allocated by the first insertion (power of two)
+#define HT_GENERIC_INITIAL_SIZE 16
+
+// Maximum load factor (in percents) the table can reach before it grows
+#define HT_GENERIC_MAX_LOAD 100
+
+// Hash of integer keys (finalizer of MurmurHash3, keys are cast to uint64_t)
+static inline uint64_t ht_generic_hash_int(uint64_t key, uint64_t seed) {
+  key ^= seed;
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  return key ^ (key >> 33);
+}
+
+// Hash of string keys
+static inline uint64_t ht_generic_hash_str(const char *key, uint64_t seed) {
+  return ht_hash_wy(key, strlen(key), seed);
+}
+
+// Equality of keys comparable by ==
+#define HT_GENERIC_EQ(A, B) ((A) == (B))
+
+// Equality of string keys
+#define HT_GENERIC_STREQ(A, B) (strcmp((A), (B)) == 0)
+
+#define HTDEC(K, V, TNAME)                                                     \
+  typedef struct ht_##TNAME##_item {                                           \
+    K key;                                                                     \
+    V value;                                                                   \
+    uint64_t hash;                                                             \
+    struct ht_##TNAME##_item *next;                                            \
+  } ht_##TNAME##_item_t;                                                       \
+                                                                               \
+  typedef struct {                                                             \
+    ht_##TNAME##_item_t **buckets;                                             \
+    size_t size;                                                               \
+    size_t count;                                                              \
+    uint64_t seed;                                                             \
+  } ht_##TNAME##_table_t;                                                      \
+                                                                               \
+  void ht_##TNAME##_init(ht_##TNAME##_table_t *table);                         \
+  ht_##TNAME##_item_t *ht_##TNAME##_search(ht_##TNAME##_table_t *table,        \
+                                           K key);                             \
+  void ht_##TNAME##_insert(ht_##TNAME##_table_t *table, K key, V value);       \
+  V *ht_##TNAME##_get(ht_##TNAME##_table_t *table, K key);                     \
+  bool ht_##TNAME##_delete(ht_##TNAME##_table_t *table, K key);                \
+  void ht_##TNAME##_delete_all(ht_##TNAME##_table_t *table);
+
+#define HTDEF(K, V, TNAME, HASH, EQUAL)                                        \
+  void ht_##TNAME##_init(ht_##TNAME##_table_t *table) {                        \
+    table->buckets = NULL;                                                     \
+    table->size = 0;                                                           \
+    table->count = 0;                                                          \
+    table->seed = ht_hash_random_seed();                                       \
+  }                                                                            \
+                                                                               \
+  static ht_##TNAME##_item_t **ht_##TNAME##_find(                              \
+      ht_##TNAME##_table_t *table, K key, uint64_t hash) {                     \
+    ht_##TNAME##_item_t **link = &table->buckets[hash & (table->size - 1)];    \
+    while (*link != NULL &&                                                    \
+           ((*link)->hash != hash || !(EQUAL((*link)->key, key)))) {           \
+      link = &(*link)->next;                                                   \
+    }                                                                          \
+    return link;                                                               \
+  }                                                                            \
+                                                                               \
+  static void ht_##TNAME##_grow(ht_##TNAME##_table_t *table) {                 \
+    size_t size = table->size * 2;                                             \
+    ht_##TNAME##_item_t **buckets = calloc(size, sizeof(*buckets));            \
+    if (buckets == NULL) {                                                     \
+      return;                                                                  \
+    }                                                                          \
+    for (size_t i = 0; i < table->size; i++) {                                 \
+      ht_##TNAME##_item_t *item = table->buckets[i];                           \
+      while (item != NULL) {                                                   \
+        ht_##TNAME##_item_t *next = item->next;                                \
+        item->next = buckets[item->hash & (size - 1)];                         \
+        buckets[item->hash & (size - 1)] = item;                               \
+        item = next;                                                           \
+      }                                                                        \
+    }                                                                          \
+    free(table->buckets);                                                      \
+    table->buckets = buckets;                                                  \
+    table->size = size;                                                        \
+  }                                                                            \
+                                                                               \
+  ht_##TNAME##_item_t *ht_##TNAME##_search(ht_##TNAME##_table_t *table,        \
+                                           K key) {                            \
+    if (table->size == 0) {                                                    \
+      return NULL;                                                             \
+    }                                                                          \
+    return *ht_##TNAME##_find(table, key, HASH(key, table->seed));             \
+  }                                                                            \
+                                                                               \
+  void ht_##TNAME##_insert(ht_##TNAME##_table_t *table, K key, V value) {      \
+    if (table->size == 0) {                                                    \
+      table->buckets =                                                         \
+          calloc(HT_GENERIC_INITIAL_SIZE, sizeof(*table->buckets));            \
+      if (table->buckets == NULL) {                                            \
+        return;                                                                \
+      }                                                                        \
+      table->size = HT_GENERIC_INITIAL_SIZE;                                   \
+    }                                                                          \
+    uint64_t hash = HASH(key, table->seed);                                    \
+    ht_##TNAME##_item_t **link = ht_##TNAME##_find(table, key, hash);          \
+    if (*link != NULL) {                                                       \
+      (*link)->value = value;                                                  \
+      return;                                                                  \
+    }                                                                          \
+    ht_##TNAME##_item_t *item = malloc(sizeof(ht_##TNAME##_item_t));           \
+    if (item == NULL) {                                                        \
+      return;                                                                  \
+    }                                                                          \
+    item->key = key;                                                           \
+    item->value = value;                                                       \
+    item->hash = hash;                                                         \
+    item->next = table->buckets[hash & (table->size - 1)];                     \
+    table->buckets[hash & (table->size - 1)] = item;                           \
+    table->count++;                                                            \
+    if (table->count * 100 > table->size * HT_GENERIC_MAX_LOAD) {              \
+      ht_##TNAME##_grow(table);                                                \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  V *ht_##TNAME##_get(ht_##TNAME##_table_t *table, K key) {                    \
+    ht_##TNAME##_item_t *item = ht_##TNAME##_search(table, key);               \
+    return item != NULL ? &item->value : NULL;                                 \
+  }                                                                            \
+                                                                               \
+  bool ht_##TNAME##_delete(ht_##TNAME##_table_t *table, K key) {               \
+    if (table->size == 0) {                                                    \
+      return false;                                                            \
+    }                                                                          \
+    ht_##TNAME##_item_t **link =                                               \
+        ht_##TNAME##_find(table, key, HASH(key, table->seed));                 \
+    if (*link == NULL) {                                                       \
+      return false;                                                            \
+    }                                                                          \
+    ht_##TNAME##_item_t *item = *link;                                         \
+    *link = item->next;                                                        \
+    free(item);                                                                \
+    table->count--;                                                            \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  void ht_##TNAME##_delete_all(ht_##TNAME##_table_t *table) {                  \
+    for (size_t i = 0; i < table->size; i++) {                                 \
+      ht_##TNAME##_item_t *item = table->buckets[i];                           \
+      while (item != NULL) {                                                   \
+        ht_##TNAME##_item_t *next = item->next;                                \
+        free(item);                                                            \
+        item = next;                                                           \
+      }                                                                        \
+    }                                                                          \
+    free(table->buckets);                                                      \
+    table->buckets = NULL;                                                     \
+    table->size = 0;                                                           \
+    table->count = 0;                                                          \
+  }
+
+// Tables used by the library itself (integer and string keys)
+HTDEC(uint64_t, float, u64)
+HTDEC(char *, float, str)
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * String hash functions
+ *
+ * ht_hash_wy is the default one. It is based on wyhash: keys are processed
+ * by 8 bytes (16 bytes per round) and the state is mixed by 64x64->128 bit
+ * multiplication, which is both fast and well distributed in all the bits.
+ * The other functions are kept for comparison in benchmarks.
+ */
+
+#include "hash.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+ht_hash_fn_t ht_hash_function = ht_hash_wy;
+uint64_t ht_hash_seed = 0;
+
+// Secret constants of wyhash
+static const uint64_t wy_secret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                      0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+/*
+ * Multiplies A and B, A gets low 64 bits of the result, B gets high 64 bits.
+ */
+static inline void wy_mum(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128_t;
+    uint128_t result = (uint128_t) *a * *b;
+    *a = (uint64_t) result;
+    *b = (uint64_t) (result >> 64);
+#else
+    // Schoolbook multiplication by 32-bit halves
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), carry = t < rl;
+    uint64_t low = t + (rm1 << 32);
+    carry += low < t;
+    *a = low;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+// Reading of (possibly unaligned) little parts of the key
+static inline uint64_t wy_read8(const unsigned char *p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t wy_read4(const unsigned char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t wy_read3(const unsigned char *p, size_t k) {
+    return ((uint64_t) p[0] << 16) | ((uint64_t) p[k >> 1] << 8) | p[k - 1];
+}
+
+/*
+ * Hash function based on wyhash (final version 4).
+ */
+uint64_t ht_hash_wy(const char *key, size_t length, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *) key;
+    uint64_t a, b;
+
+    seed ^= wy_mix(seed ^ wy_secret[0], wy_secret[1]);
+    if (length <= 16) {
+        if (length >= 4) {
+            // Two overlapping pairs of 4-byte words cover the whole key
+            a = (wy_read4(p) << 32) | wy_read4(p + ((length >> 3) << 2));
+            b = (wy_read4(p + length - 4) << 32) | wy_read4(p + length - 4 - ((length >> 3) << 2));
+        } else if (length > 0) {
+            a = wy_read3(p, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = length;
+        if (i > 48) {
+            // Three independent lanes, so the multiplications can overlap
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wy_mix(wy_read8(p) ^ wy_secret[1], wy_read8(p + 8) ^ seed);
+                see1 = wy_mix(wy_read8(p + 16) ^ wy_secret[2], wy_read8(p + 24) ^ see1);
+                see2 = wy_mix(wy_read8(p + 32) ^ wy_secret[3], wy_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = wy_mix(wy_read8(p) ^ wy_secret[1], wy_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        // Last 16 bytes (may overlap already processed ones)
+        a = wy_read8(p + i - 16);
+        b = wy_read8(p + i - 8);
+    }
+
+    a ^= wy_secret[1];
+    b ^= seed;
+    wy_mum(&a, &b);
+
+    return wy_mix(a ^ wy_secret[0] ^ length, b ^ wy_secret[1]);
+}
+
+/*
+ * FNV-1a hash function (byte by byte). Seed is mixed into the offset basis.
+ */
+uint64_t ht_hash_fnv1a(const char *key, size_t length, uint64_t seed) {
+    uint64_t hash = 14695981039346656037ULL ^ seed;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char) key[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/*
+ * The original hash function of the fixed size table (sum of the key bytes).
+ * Anagrams always collide, whatever the seed is. Kept only for benchmarks.
+ */
+uint64_t ht_hash_additive(const char *key, size_t length, uint64_t seed) {
+    uint64_t result = 1 + seed;
+    for (size_t i = 0; i < length; i++) {
+        result += key[i];
+    }
+
+    return result;
+}
+
+/*
+ * Returns a new random seed for a hash table.
+ *
+ * Entropy is read from /dev/urandom only once per process, next seeds are
+ * derived from it by a counter, so initializing a table stays cheap. If there
+ * is no /dev/urandom, time and addresses are used instead.
+ */
+uint64_t ht_hash_random_seed() {
+    static uint64_t base = 0;
+    static uint64_t counter = 0;
+
+    if (base == 0) {
+        FILE *urandom;
+        if ((urandom = fopen("/dev/urandom", "rb")) != NULL) {
+            if (fread(&base, sizeof(base), 1, urandom) != 1) {
+                base = 0;
+            }
+            fclose(urandom);
+        }
+
+        if (base == 0) {
+            base = wy_mix((uint64_t) time(NULL) ^ wy_secret[2], (uint64_t) (size_t) &base ^ (uint64_t) clock());
+        }
+        base |= 1;
+    }
+
+    return wy_mix(base ^ wy_secret[3], ++counter ^ wy_secret[0]);
+}
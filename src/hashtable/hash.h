@@ -0,0 +1,33 @@
+/*
+ * Header file for string hash functions used by the hash tables.
+ *
+ * All the functions have the same signature (ht_hash_fn_t), so they can be
+ * swapped in the tables and benchmarked against each other. The seed changes
+ * the whole hash function, so keys colliding for one seed don't collide for
+ * the other one.
+ */
+
+#ifndef IAL_HASHTABLE_HASH_H
+#define IAL_HASHTABLE_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Hash function giving the full 64-bit hash of the key of the given length
+typedef uint64_t (*ht_hash_fn_t)(const char *key, size_t length,
+                                 uint64_t seed);
+
+/*
+ * Hash function and seed used by get_hash for the fixed size table.
+ * The seed is fixed by default, so the layout of ht_table_t is reproducible.
+ */
+extern ht_hash_fn_t ht_hash_function;
+extern uint64_t ht_hash_seed;
+
+uint64_t ht_hash_wy(const char *key, size_t length, uint64_t seed);
+uint64_t ht_hash_fnv1a(const char *key, size_t length, uint64_t seed);
+uint64_t ht_hash_additive(const char *key, size_t length, uint64_t seed);
+
+uint64_t ht_hash_random_seed();
+
+#endif
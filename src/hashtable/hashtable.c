@@ -9,24 +9,30 @@
  */
 
 #include "hashtable.h"
+#include "hash.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 int HT_SIZE = MAX_HT_SIZE;
 
+/*
+ * Full (not reduced) hash of the key. Items remember it, so lists of synonyms
+ * can be compared by hashes and strcmp is called only when they're equal.
+ */
+static uint64_t get_full_hash(char *key) {
+    // Sum of the key bytes made anagrams collide, so a proper hash function is used
+    // (see hash.c); ht_hash_function and ht_hash_seed allow to change it
+    return ht_hash_function(key, strlen(key), ht_hash_seed);
+}
+
 /*
  * Rozptyľovacia funkcia ktorá pridelí zadanému kľúču index z intervalu
  * <0,HT_SIZE-1>. Ideálna rozptyľovacia funkcia by mala rozprestrieť kľúče
  * rovnomerne po všetkých indexoch. Zamyslite sa nad kvalitou zvolenej funkcie.
  */
 int get_hash(char *key) {
-    int result = 1;
-    int length = strlen(key);
-    for (int i = 0; i < length; i++) {
-        result += key[i];
-    }
-
-    return (result % HT_SIZE);
+    return (int) (get_full_hash(key) % (uint64_t) HT_SIZE);
 }
 
 /*
@@ -46,11 +52,13 @@ void ht_init(ht_table_t *table) {
  */
 ht_item_t *ht_search(ht_table_t *table, char *key) {
     // Use hash function to find item with the right index
-    ht_item_t *found = (*table)[get_hash(key)];
+    uint64_t hash = get_full_hash(key);
+    ht_item_t *found = (*table)[hash % (uint64_t) HT_SIZE];
 
     // Found item hasn't to be the search one, we need equality of search key and key of the found item
     // There could be more items at one index, so we need to iterate over the list of them to find the right one
-    while (found != NULL && strcmp(found->key, key) != 0) {
+    // (keys with different hashes can't be equal, so strcmp is needed only for the same hashes)
+    while (found != NULL && (found->hash != hash || strcmp(found->key, key) != 0)) {
         found = found->next;
     }
 
@@ -76,7 +84,8 @@ void ht_insert(ht_table_t *table, char *key, float value) {
     }
 
     // Item is new --> find the right place in the table for it
-    int index = get_hash(key);
+    uint64_t hash = get_full_hash(key);
+    int index = (int) (hash % (uint64_t) HT_SIZE);
     item = (*table)[index];
 
     // Create an item
@@ -88,6 +97,7 @@ void ht_insert(ht_table_t *table, char *key, float value) {
     new_item->key = key;
     new_item->value = value;
     new_item->next = item;
+    new_item->hash = hash;
 
     // Add item to the first place of the selected index
     (*table)[index] = new_item;
@@ -120,10 +130,16 @@ float *ht_get(ht_table_t *table, char *key) {
  */
 void ht_delete(ht_table_t *table, char *key) {
     // Use hash function to find item with the right index
-    int index = get_hash(key);
+    uint64_t hash = get_full_hash(key);
+    int index = (int) (hash % (uint64_t) HT_SIZE);
     ht_item_t *item = (*table)[index];
 
-    if (strcmp(item->key, key) == 0) {
+    if (item == NULL) {
+        // There is no item at the index --> nothing to delete
+        return;
+    }
+
+    if (item->hash == hash && strcmp(item->key, key) == 0) {
         // It's the first item at the index
         // Move to the next item (or NULL if item for deletion is the last one)
         (*table)[index] = item->next;
@@ -137,7 +153,7 @@ void ht_delete(ht_table_t *table, char *key) {
     // There is more items at the index or item for deletion isn't in the table at all
     // We need to find item for deletion in the list of synonyms
     ht_item_t *prev_item = item;
-    while (item != NULL && strcmp(item->key, key) != 0) {
+    while (item != NULL && (item->hash != hash || strcmp(item->key, key) != 0)) {
         prev_item = item;
         item = item->next;
     }
@@ -165,9 +181,9 @@ void ht_delete_all(ht_table_t *table) {
         ht_item_t *next = item;
         while (next != NULL) {
             item = next;
-            free(item);
+            next = item->next;
 
-            next = next->next;
+            free(item);
         }
 
         // Set list of synonyms as empty
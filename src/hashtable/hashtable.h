@@ -7,12 +7,15 @@
 #define IAL_HASHTABLE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /*
  * Maximálna veľkosť poľa pre implementáciu tabuľky.
  * Funkcie pracujúce s tabuľkou uvažujú veľkosť HT_SIZE.
  */
+#ifndef MAX_HT_SIZE
 #define MAX_HT_SIZE 101
+#endif
 
 /*
  * Veľkosť tabuľky s ktorou pracujú implementované funkcie.
@@ -26,6 +29,7 @@ typedef struct ht_item {
   char *key;            // kľúč prvku
   float value;          // hodnota prvku
   struct ht_item *next; // ukazateľ na ďalšie synonymum
+  uint64_t hash;        // úplný (nezredukovaný) hash kľúča
 } ht_item_t;
 
 // Tabuľka o reálnej veľkosti MAX_HT_SIZE
@@ -0,0 +1,499 @@
+/*
+ * Hash table with lock-free reads
+ *
+ * Every shard has its own bucket array and a mutex serializing its writers.
+ * Readers load the bucket array, the bucket head and every next pointer with
+ * acquire loads; writers fill the whole item (or the whole grown array) first
+ * and then publish it by a single release store, so a reader never sees
+ * a half-initialized object.
+ *
+ * Items are never moved between chains in place: growing copies the items
+ * into a new array, publishes it and retires the old array and items. Deleted
+ * items are only unlinked (their next pointer stays valid for readers which
+ * currently stand on them) and retired. Retired objects are freed by the
+ * epoch-based reclamation described in lf_table.h.
+ */
+
+#include "lf_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline uint64_t lf_hash(ht_lf_table_t *table, const char *key) {
+    return table->hash(key, strlen(key), table->seed);
+}
+
+/*
+ * Returns the shard which the key with the hash belongs to.
+ */
+static inline ht_lf_shard_t *lf_shard(ht_lf_table_t *table, uint64_t hash) {
+    return &table->shards[(size_t) (hash >> 48) & (table->shard_count - 1)];
+}
+
+/*
+ * Allocates an empty bucket array. Returns NULL if there is not enough memory.
+ */
+static ht_lf_buckets_t *lf_alloc_buckets(size_t size) {
+    ht_lf_buckets_t *buckets;
+    if ((buckets = calloc(1, sizeof(ht_lf_buckets_t) + size * sizeof(ht_item_t *))) == NULL) {
+        return NULL;
+    }
+
+    buckets->size = size;
+
+    return buckets;
+}
+
+/*
+ * Frees the bucket array with all of its items at once (nobody can read them).
+ */
+static void lf_free_buckets(ht_lf_buckets_t *buckets) {
+    if (buckets == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < buckets->size; i++) {
+        ht_item_t *item = buckets->heads[i];
+        while (item != NULL) {
+            ht_item_t *next = item->next;
+            free(item);
+            item = next;
+        }
+    }
+
+    free(buckets);
+}
+
+/*
+ * Returns pointer to the link (bucket head or next pointer of the previous
+ * item) pointing to the item with the key, or to the terminating NULL link.
+ * Only writers (holding the lock of the shard) can use it.
+ */
+static ht_item_t **lf_find_link(ht_lf_buckets_t *buckets, char *key, uint64_t hash) {
+    ht_item_t **link = &buckets->heads[hash & (buckets->size - 1)];
+    while (*link != NULL && ((*link)->hash != hash || strcmp((*link)->key, key) != 0)) {
+        link = &(*link)->next;
+    }
+
+    return link;
+}
+
+/*
+ * Tries to move the global epoch forward. It is possible only if all the
+ * readers which are reading right now have started in the current epoch.
+ */
+static void lf_try_advance(ht_lf_table_t *table) {
+    uint64_t epoch = __atomic_load_n(&table->epoch, __ATOMIC_SEQ_CST);
+    for (size_t i = 0; i < HT_LF_MAX_READERS; i++) {
+        uint64_t state = __atomic_load_n(&table->readers[i].state, __ATOMIC_SEQ_CST);
+        if ((state & 1) != 0 && state >> 1 != epoch) {
+            return;
+        }
+    }
+
+    // Another writer could have moved it already --> result doesn't matter
+    __atomic_compare_exchange_n(&table->epoch, &epoch, epoch + 1, false, __ATOMIC_SEQ_CST,
+                                __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Frees retired objects of the shard which can't be reached by any reader.
+ * The caller holds the lock of the shard.
+ */
+static void lf_reclaim_shard(ht_lf_table_t *table, ht_lf_shard_t *shard) {
+    lf_try_advance(table);
+    uint64_t epoch = __atomic_load_n(&table->epoch, __ATOMIC_SEQ_CST);
+
+    ht_lf_retired_t **link = &shard->retired;
+    while (*link != NULL) {
+        ht_lf_retired_t *retired = *link;
+        if (retired->epoch + 2 <= epoch) {
+            *link = retired->next;
+            free(retired->memory);
+            shard->retired_count--;
+        } else {
+            link = &retired->next;
+        }
+    }
+
+    // Objects readers are still holding aren't checked again and again
+    shard->reclaim_at = shard->retired_count * 2;
+    if (shard->reclaim_at < HT_LF_RECLAIM) {
+        shard->reclaim_at = HT_LF_RECLAIM;
+    }
+}
+
+/*
+ * Adds already unlinked object to the objects waiting for reclamation.
+ */
+static void lf_retire(ht_lf_table_t *table, ht_lf_shard_t *shard, ht_lf_retired_t *retired,
+                      void *memory) {
+    // Readers starting after the epoch is read must not see the object anymore
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    retired->memory = memory;
+    retired->epoch = __atomic_load_n(&table->epoch, __ATOMIC_SEQ_CST);
+    retired->next = shard->retired;
+    shard->retired = retired;
+    shard->retired_count++;
+}
+
+/*
+ * Retires the bucket array with all of its items.
+ */
+static void lf_retire_buckets(ht_lf_table_t *table, ht_lf_shard_t *shard, ht_lf_buckets_t *buckets) {
+    for (size_t i = 0; i < buckets->size; i++) {
+        for (ht_item_t *item = buckets->heads[i]; item != NULL; item = item->next) {
+            lf_retire(table, shard, &((ht_lf_item_t *) item)->retired, item);
+        }
+    }
+
+    lf_retire(table, shard, &buckets->retired, buckets);
+}
+
+/*
+ * Doubles the bucket array of the shard if it is too loaded. Items are copied
+ * into the new array, so readers of the old one aren't disturbed.
+ */
+static void lf_grow_if_needed(ht_lf_table_t *table, ht_lf_shard_t *shard) {
+    ht_lf_buckets_t *old = shard->buckets;
+    if (shard->count * 100 <= old->size * HT_LF_MAX_LOAD) {
+        return;
+    }
+
+    ht_lf_buckets_t *buckets;
+    if ((buckets = lf_alloc_buckets(old->size * 2)) == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < old->size; i++) {
+        for (ht_item_t *item = old->heads[i]; item != NULL; item = item->next) {
+            ht_lf_item_t *copy;
+            if ((copy = malloc(sizeof(ht_lf_item_t))) == NULL) {
+                // The shard keeps the old array, it just stays more loaded
+                lf_free_buckets(buckets);
+                return;
+            }
+
+            size_t index = item->hash & (buckets->size - 1);
+            copy->item = *item;
+            copy->item.next = buckets->heads[index];
+            buckets->heads[index] = &copy->item;
+        }
+    }
+
+    __atomic_store_n(&shard->buckets, buckets, __ATOMIC_RELEASE);
+    lf_retire_buckets(table, shard, old);
+}
+
+/*
+ * Initialization of the table — call it before the first usage of the table.
+ *
+ * The number of shards is rounded up to a power of two. Returns false if
+ * there is not enough memory (the table can't be used then).
+ */
+bool ht_lf_init(ht_lf_table_t *table, size_t shards) {
+    size_t count = 1;
+    while (count < shards && count < HT_LF_MAX_SHARDS) {
+        count *= 2;
+    }
+
+    table->shard_count = 0;
+    table->epoch = 0;
+    table->hash = ht_hash_wy;
+    table->seed = ht_hash_random_seed();
+    memset(table->readers, 0, sizeof(table->readers));
+
+    if ((table->shards = malloc(count * sizeof(ht_lf_shard_t))) == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        ht_lf_shard_t *shard = &table->shards[i];
+        if (pthread_mutex_init(&shard->lock, NULL) != 0) {
+            // Only already initialized shards are destroyed
+            table->shard_count = i;
+            ht_lf_destroy(table);
+
+            return false;
+        }
+
+        shard->buckets = NULL;
+        shard->count = 0;
+        shard->retired = NULL;
+        shard->retired_count = 0;
+        shard->reclaim_at = HT_LF_RECLAIM;
+    }
+    table->shard_count = count;
+
+    return true;
+}
+
+/*
+ * Releasing the table — all items (including the retired ones) are freed and
+ * locks are destroyed. No reader can be reading the table.
+ */
+void ht_lf_destroy(ht_lf_table_t *table) {
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ht_lf_shard_t *shard = &table->shards[i];
+        lf_free_buckets(shard->buckets);
+
+        while (shard->retired != NULL) {
+            ht_lf_retired_t *next = shard->retired->next;
+            free(shard->retired->memory);
+            shard->retired = next;
+        }
+
+        pthread_mutex_destroy(&shard->lock);
+    }
+
+    free(table->shards);
+    table->shards = NULL;
+    table->shard_count = 0;
+}
+
+/*
+ * Changes hash function and seed of the table.
+ *
+ * It can be done only while the table is empty and nobody else uses it.
+ * Returns true if the function has been changed.
+ */
+bool ht_lf_set_hash(ht_lf_table_t *table, ht_hash_fn_t hash, uint64_t seed) {
+    if (ht_lf_count(table) != 0) {
+        return false;
+    }
+
+    table->hash = hash;
+    table->seed = seed;
+
+    return true;
+}
+
+/*
+ * Registers a reader thread. Every thread reading the table needs its own
+ * reader. Returns NULL if all HT_LF_MAX_READERS slots are used.
+ */
+ht_lf_reader_t *ht_lf_register(ht_lf_table_t *table) {
+    for (size_t i = 0; i < HT_LF_MAX_READERS; i++) {
+        int unused = 0;
+        if (__atomic_compare_exchange_n(&table->readers[i].used, &unused, 1, false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_RELAXED)) {
+            return &table->readers[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Releases the slot of the reader (it can't be in a read section).
+ */
+void ht_lf_unregister(ht_lf_reader_t *reader) {
+    __atomic_store_n(&reader->used, 0, __ATOMIC_RELEASE);
+}
+
+/*
+ * Starts a read section. Items returned by ht_lf_search are valid until the
+ * end of the section, so it should be short (it holds back reclamation).
+ */
+void ht_lf_read_begin(ht_lf_table_t *table, ht_lf_reader_t *reader) {
+    uint64_t epoch = __atomic_load_n(&table->epoch, __ATOMIC_SEQ_CST);
+
+    // Sequentially consistent store, so no load of the table goes before it
+    __atomic_store_n(&reader->state, epoch << 1 | 1, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Ends the read section.
+ */
+void ht_lf_read_end(ht_lf_reader_t *reader) {
+    __atomic_store_n(&reader->state, 0, __ATOMIC_RELEASE);
+}
+
+/*
+ * Searching for an item in the table (inside of a read section).
+ *
+ * Returns pointer to the found item or NULL if there is no item with the key.
+ * Value of the item has to be read by an atomic load, writers can change it.
+ */
+ht_item_t *ht_lf_search(ht_lf_table_t *table, char *key) {
+    uint64_t hash = lf_hash(table, key);
+    ht_lf_shard_t *shard = lf_shard(table, hash);
+
+    ht_lf_buckets_t *buckets = __atomic_load_n(&shard->buckets, __ATOMIC_ACQUIRE);
+    if (buckets == NULL) {
+        return NULL;
+    }
+
+    ht_item_t *item = __atomic_load_n(&buckets->heads[hash & (buckets->size - 1)], __ATOMIC_ACQUIRE);
+    while (item != NULL) {
+        if (item->hash == hash && strcmp(item->key, key) == 0) {
+            return item;
+        }
+
+        item = __atomic_load_n(&item->next, __ATOMIC_ACQUIRE);
+    }
+
+    return NULL;
+}
+
+/*
+ * Getting value of the item from the table (the read section is made here).
+ *
+ * The value is copied into the value parameter. Returns false if there is no
+ * item with the key (value isn't changed then).
+ */
+bool ht_lf_get(ht_lf_table_t *table, ht_lf_reader_t *reader, char *key, float *value) {
+    ht_lf_read_begin(table, reader);
+
+    ht_item_t *item = ht_lf_search(table, key);
+    if (item != NULL) {
+        __atomic_load(&item->value, value, __ATOMIC_RELAXED);
+    }
+
+    ht_lf_read_end(reader);
+
+    return item != NULL;
+}
+
+/*
+ * Inserting a new item into the table.
+ *
+ * If there already is an item with the key, only its value is replaced.
+ */
+void ht_lf_insert(ht_lf_table_t *table, char *key, float value) {
+    uint64_t hash = lf_hash(table, key);
+    ht_lf_shard_t *shard = lf_shard(table, hash);
+
+    pthread_mutex_lock(&shard->lock);
+
+    if (shard->buckets == NULL) {
+        ht_lf_buckets_t *buckets;
+        if ((buckets = lf_alloc_buckets(HT_LF_INITIAL_SIZE)) == NULL) {
+            pthread_mutex_unlock(&shard->lock);
+            return;
+        }
+
+        __atomic_store_n(&shard->buckets, buckets, __ATOMIC_RELEASE);
+    }
+
+    ht_item_t **link = lf_find_link(shard->buckets, key, hash);
+    if (*link != NULL) {
+        // Item is already in the table --> only change its value
+        __atomic_store(&(*link)->value, &value, __ATOMIC_RELAXED);
+
+        pthread_mutex_unlock(&shard->lock);
+        return;
+    }
+
+    ht_lf_item_t *new_item;
+    if ((new_item = malloc(sizeof(ht_lf_item_t))) == NULL) {
+        pthread_mutex_unlock(&shard->lock);
+        return;
+    }
+
+    // The item is complete before readers can reach it
+    ht_item_t **head = &shard->buckets->heads[hash & (shard->buckets->size - 1)];
+    new_item->item.key = key;
+    new_item->item.value = value;
+    new_item->item.hash = hash;
+    new_item->item.next = *head;
+    __atomic_store_n(head, &new_item->item, __ATOMIC_RELEASE);
+    shard->count++;
+
+    lf_grow_if_needed(table, shard);
+    if (shard->retired_count >= shard->reclaim_at) {
+        lf_reclaim_shard(table, shard);
+    }
+
+    pthread_mutex_unlock(&shard->lock);
+}
+
+/*
+ * Deleting an item from the table.
+ *
+ * The item is only unlinked, its memory is freed after all the readers which
+ * could have seen it leave their read sections. If there is no item with the
+ * key, nothing happens.
+ */
+void ht_lf_delete(ht_lf_table_t *table, char *key) {
+    uint64_t hash = lf_hash(table, key);
+    ht_lf_shard_t *shard = lf_shard(table, hash);
+
+    pthread_mutex_lock(&shard->lock);
+
+    ht_item_t **link;
+    if (shard->buckets == NULL || *(link = lf_find_link(shard->buckets, key, hash)) == NULL) {
+        pthread_mutex_unlock(&shard->lock);
+        return;
+    }
+
+    // Next pointer of the deleted item stays, readers standing on it can go on
+    ht_item_t *item = *link;
+    __atomic_store_n(link, item->next, __ATOMIC_RELEASE);
+    lf_retire(table, shard, &((ht_lf_item_t *) item)->retired, item);
+    shard->count--;
+
+    if (shard->retired_count >= shard->reclaim_at) {
+        lf_reclaim_shard(table, shard);
+    }
+
+    pthread_mutex_unlock(&shard->lock);
+}
+
+/*
+ * Deleting all items from the table.
+ *
+ * Bucket arrays are unlinked shard by shard and retired as a whole.
+ */
+void ht_lf_delete_all(ht_lf_table_t *table) {
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ht_lf_shard_t *shard = &table->shards[i];
+        pthread_mutex_lock(&shard->lock);
+
+        ht_lf_buckets_t *buckets = shard->buckets;
+        if (buckets != NULL) {
+            __atomic_store_n(&shard->buckets, NULL, __ATOMIC_RELEASE);
+            lf_retire_buckets(table, shard, buckets);
+            shard->count = 0;
+            lf_reclaim_shard(table, shard);
+        }
+
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+/*
+ * Returns number of items in the table (shards are counted one by one, so it
+ * is only approximate while other threads modify the table).
+ */
+size_t ht_lf_count(ht_lf_table_t *table) {
+    size_t count = 0;
+    for (size_t i = 0; i < table->shard_count; i++) {
+        pthread_mutex_lock(&table->shards[i].lock);
+        count += table->shards[i].count;
+        pthread_mutex_unlock(&table->shards[i].lock);
+    }
+
+    return count;
+}
+
+/*
+ * Frees all the retired objects no reader can reach. Returns number of
+ * objects which are still waiting (some reader may be using them).
+ */
+size_t ht_lf_reclaim(ht_lf_table_t *table) {
+    size_t waiting = 0;
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ht_lf_shard_t *shard = &table->shards[i];
+        pthread_mutex_lock(&shard->lock);
+
+        // Objects retired in the current epoch need two steps of the epoch
+        lf_reclaim_shard(table, shard);
+        lf_reclaim_shard(table, shard);
+        waiting += shard->retired_count;
+
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    return waiting;
+}
@@ -0,0 +1,109 @@
+/*
+ * Header file for the hash table with lock-free reads.
+ *
+ * Readers don't take any lock: chains are traversed by atomic loads and
+ * writers publish their changes by atomic stores, so a reader always sees
+ * a consistent chain. Writers are serialized by a mutex of their shard.
+ *
+ * Memory of deleted items (and of bucket arrays replaced by growing) is
+ * reclaimed by epochs: a reader announces the epoch it started in, and an
+ * object unlinked in epoch E is freed once the table reached epoch E + 2,
+ * which is possible only after all readers which could see it have left.
+ */
+
+#ifndef IAL_HASHTABLE_LF_TABLE_H
+#define IAL_HASHTABLE_LF_TABLE_H
+
+#include "hash.h"
+#include "hashtable.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Maximum number of shards (the shard is selected by upper 16 bits of hash)
+#define HT_LF_MAX_SHARDS 65536
+
+// Maximum number of concurrently registered readers
+#define HT_LF_MAX_READERS 128
+
+// Number of buckets allocated by the first insertion into a shard
+#define HT_LF_INITIAL_SIZE 16
+
+// Maximum load factor (in percents) a shard can reach before it grows
+#define HT_LF_MAX_LOAD 100
+
+// Number of retired objects of a shard which triggers their reclamation
+#define HT_LF_RECLAIM 64
+
+// Size of cache line, readers and shards are padded to not share their lines
+#define HT_LF_CACHE_LINE 64
+
+// Object waiting for reclamation
+typedef struct ht_lf_retired {
+  struct ht_lf_retired *next; // next retired object of the shard
+  void *memory;               // allocation to be freed
+  uint64_t epoch;             // epoch in which the object was unlinked
+} ht_lf_retired_t;
+
+// Item of the table
+typedef struct ht_lf_item {
+  ht_item_t item;          // item itself (key, value and synonyms)
+  ht_lf_retired_t retired; // record used after the item is deleted
+} ht_lf_item_t;
+
+// Bucket array of a shard
+typedef struct ht_lf_buckets {
+  ht_lf_retired_t retired; // record used after the array is replaced
+  size_t size;             // number of buckets (power of two)
+  ht_item_t *heads[];      // first items of the buckets
+} ht_lf_buckets_t;
+
+// Slot of a reader thread
+typedef struct ht_lf_reader {
+  uint64_t state;                      // 0 or (epoch << 1) | 1 while reading
+  int used;                            // the slot is registered
+  char padding[HT_LF_CACHE_LINE - 12]; // separation from the next slot
+} ht_lf_reader_t;
+
+// Shard of the table
+typedef struct ht_lf_shard {
+  pthread_mutex_t lock;           // lock of writers
+  ht_lf_buckets_t *buckets;       // bucket array, NULL if none
+  size_t count;                   // number of stored items
+  ht_lf_retired_t *retired;       // objects waiting for reclamation
+  size_t retired_count;           // number of the waiting objects
+  size_t reclaim_at;              // retired_count triggering reclamation
+  char padding[HT_LF_CACHE_LINE]; // separation from the next shard
+} ht_lf_shard_t;
+
+// Table with lock-free reads
+typedef struct ht_lf_table {
+  ht_lf_shard_t *shards;                     // shard array
+  size_t shard_count;                        // number of shards (power of two)
+  uint64_t epoch;                            // global epoch
+  ht_lf_reader_t readers[HT_LF_MAX_READERS]; // slots of readers
+  ht_hash_fn_t hash;                         // hash function
+  uint64_t seed;                             // seed of the hash function
+} ht_lf_table_t;
+
+bool ht_lf_init(ht_lf_table_t *table, size_t shards);
+void ht_lf_destroy(ht_lf_table_t *table);
+
+ht_lf_reader_t *ht_lf_register(ht_lf_table_t *table);
+void ht_lf_unregister(ht_lf_reader_t *reader);
+void ht_lf_read_begin(ht_lf_table_t *table, ht_lf_reader_t *reader);
+void ht_lf_read_end(ht_lf_reader_t *reader);
+
+ht_item_t *ht_lf_search(ht_lf_table_t *table, char *key);
+bool ht_lf_get(ht_lf_table_t *table, ht_lf_reader_t *reader, char *key,
+               float *value);
+void ht_lf_insert(ht_lf_table_t *table, char *key, float value);
+void ht_lf_delete(ht_lf_table_t *table, char *key);
+void ht_lf_delete_all(ht_lf_table_t *table);
+
+bool ht_lf_set_hash(ht_lf_table_t *table, ht_hash_fn_t hash, uint64_t seed);
+size_t ht_lf_count(ht_lf_table_t *table);
+size_t ht_lf_reclaim(ht_lf_table_t *table);
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Frozen table with minimal perfect hashing (CHD: compress, hash, displace)
+ *
+ * Keys are split into bucket_count buckets by the upper half of their hash.
+ * Buckets are placed from the biggest one: for each of them, displacements
+ * 0, 1, 2, ... are tried until all the keys of the bucket map to slots which
+ * are still free. Most buckets are placed by one of the first few
+ * displacements, because the big buckets are placed while the table is
+ * almost empty.
+ *
+ * The slot of a key with hash h in a bucket with displacement d is
+ * reduce(mix(h + d * C), count), where mix is a 64-bit finalizer and reduce
+ * maps a 32-bit value to <0, count) by a multiplication instead of a modulo.
+ */
+
+#include "mph.h"
+#include "hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Odd constant spreading displacements over the 64-bit values
+#define MPH_DISPLACEMENT_STEP 0x9e3779b97f4a7c15ULL
+
+/*
+ * Maps the 32-bit value to <0, range).
+ */
+static inline uint32_t mph_reduce(uint32_t value, uint32_t range) {
+    return (uint32_t) (((uint64_t) value * range) >> 32);
+}
+
+static inline uint32_t mph_bucket(ht_mph_table_t *mph, uint64_t hash) {
+    return mph_reduce((uint32_t) (hash >> 32), mph->bucket_count);
+}
+
+static inline uint32_t mph_slot(ht_mph_table_t *mph, uint64_t hash, uint32_t displacement) {
+    uint64_t x = hash + displacement * MPH_DISPLACEMENT_STEP;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+
+    return mph_reduce((uint32_t) (x >> 32), mph->count);
+}
+
+/*
+ * Tries to place all the items with the current seed. Items are given sorted
+ * by buckets, starts[b] is index of the first item of bucket b. Returns false
+ * if some bucket can't be placed.
+ */
+static bool mph_place(ht_mph_table_t *mph, ht_mph_item_t *items, uint32_t *starts, uint32_t *order,
+                      bool *taken, uint32_t *slots) {
+    memset(taken, 0, mph->count * sizeof(bool));
+
+    for (uint32_t i = 0; i < mph->bucket_count; i++) {
+        uint32_t bucket = order[i];
+        uint32_t first = starts[bucket];
+        uint32_t size = starts[bucket + 1] - first;
+        if (size == 0) {
+            // Buckets are sorted by size, only empty ones follow
+            break;
+        }
+
+        uint32_t displacement = 0;
+        for (;; displacement++) {
+            if (displacement == HT_MPH_MAX_DISPLACEMENT) {
+                return false;
+            }
+
+            // All the slots have to be free and different from each other
+            uint32_t placed = 0;
+            while (placed < size) {
+                uint32_t slot = mph_slot(mph, items[first + placed].hash, displacement);
+                if (taken[slot]) {
+                    break;
+                }
+
+                taken[slot] = true;
+                slots[placed++] = slot;
+            }
+
+            if (placed == size) {
+                break;
+            }
+
+            // Release slots taken by this attempt
+            while (placed > 0) {
+                taken[slots[--placed]] = false;
+            }
+        }
+
+        mph->displacements[bucket] = displacement;
+        for (uint32_t j = 0; j < size; j++) {
+            mph->items[slots[j]] = items[first + j];
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Builds frozen table of all the items of the table (the table isn't changed
+ * and it can be deleted later, but the keys have to stay valid).
+ *
+ * Returns false if there is not enough memory or no perfect hash function has
+ * been found (two different keys with the same 64-bit hash for all the tried
+ * seeds). The frozen table can't be used then.
+ */
+bool ht_mph_build(ht_mph_table_t *mph, ht_table_t *table) {
+    size_t count = 0;
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            count++;
+        }
+    }
+
+    memset(mph, 0, sizeof(*mph));
+    if (count >= UINT32_MAX / 2) {
+        return false;
+    }
+
+    mph->count = (uint32_t) count;
+    mph->bucket_count = (uint32_t) (count / HT_MPH_BUCKET_SIZE + 1);
+
+    ht_mph_item_t *items = malloc((count + 1) * sizeof(ht_mph_item_t));
+    ht_mph_item_t *sorted = malloc((count + 1) * sizeof(ht_mph_item_t));
+    uint32_t *starts = malloc((mph->bucket_count + 1) * sizeof(uint32_t));
+    uint32_t *order = malloc(mph->bucket_count * sizeof(uint32_t));
+    uint32_t *slots = malloc((count + 1) * sizeof(uint32_t));
+    bool *taken = malloc(count + 1);
+    mph->items = malloc((count + 1) * sizeof(ht_mph_item_t));
+    mph->displacements = malloc(mph->bucket_count * sizeof(uint32_t));
+
+    bool built = false;
+    if (items != NULL && sorted != NULL && starts != NULL && order != NULL && slots != NULL && taken != NULL &&
+        mph->items != NULL && mph->displacements != NULL) {
+        count = 0;
+        for (int i = 0; i < HT_SIZE; i++) {
+            for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+                items[count].key = item->key;
+                items[count].value = item->value;
+                count++;
+            }
+        }
+
+        for (int attempt = 0; attempt < HT_MPH_ATTEMPTS && !built; attempt++) {
+            mph->seed = ht_hash_seed + (uint64_t) attempt * MPH_DISPLACEMENT_STEP;
+
+            // Sort items by buckets (counting sort)
+            memset(starts, 0, (mph->bucket_count + 1) * sizeof(uint32_t));
+            for (uint32_t i = 0; i < mph->count; i++) {
+                items[i].hash = ht_hash_wy(items[i].key, strlen(items[i].key), mph->seed);
+                starts[mph_bucket(mph, items[i].hash) + 1]++;
+            }
+            for (uint32_t b = 0; b < mph->bucket_count; b++) {
+                starts[b + 1] += starts[b];
+                order[b] = starts[b];
+            }
+            for (uint32_t i = 0; i < mph->count; i++) {
+                sorted[order[mph_bucket(mph, items[i].hash)]++] = items[i];
+            }
+
+            // Order buckets from the biggest one (counting sort by their sizes)
+            uint32_t max_size = 0;
+            for (uint32_t b = 0; b < mph->bucket_count; b++) {
+                uint32_t size = starts[b + 1] - starts[b];
+                max_size = size > max_size ? size : max_size;
+            }
+            uint32_t position = 0;
+            for (uint32_t size = max_size + 1; size-- > 0;) {
+                for (uint32_t b = 0; b < mph->bucket_count; b++) {
+                    if (starts[b + 1] - starts[b] == size) {
+                        order[position++] = b;
+                    }
+                }
+            }
+
+            built = mph_place(mph, sorted, starts, order, taken, slots);
+        }
+    }
+
+    free(items);
+    free(sorted);
+    free(starts);
+    free(order);
+    free(slots);
+    free(taken);
+    if (!built) {
+        ht_mph_destroy(mph);
+    }
+
+    return built;
+}
+
+/*
+ * Searching for an item in the frozen table.
+ *
+ * Returns pointer to the found item or NULL if there is no item with the key.
+ */
+ht_mph_item_t *ht_mph_search(ht_mph_table_t *mph, char *key) {
+    if (mph->count == 0) {
+        return NULL;
+    }
+
+    uint64_t hash = ht_hash_wy(key, strlen(key), mph->seed);
+    ht_mph_item_t *item = &mph->items[mph_slot(mph, hash, mph->displacements[mph_bucket(mph, hash)])];
+
+    // Every key has a slot, so only the one key stored there can be equal
+    return item->hash == hash && strcmp(item->key, key) == 0 ? item : NULL;
+}
+
+/*
+ * Getting value of the item from the frozen table.
+ *
+ * Returns pointer to the value of the item or NULL if there is no item with the
+ * key. The value can be changed through the pointer.
+ */
+float *ht_mph_get(ht_mph_table_t *mph, char *key) {
+    ht_mph_item_t *item;
+    if ((item = ht_mph_search(mph, key)) != NULL) {
+        return &item->value;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Releasing the frozen table.
+ */
+void ht_mph_destroy(ht_mph_table_t *mph) {
+    free(mph->items);
+    free(mph->displacements);
+    memset(mph, 0, sizeof(*mph));
+}
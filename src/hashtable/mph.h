@@ -0,0 +1,50 @@
+/*
+ * Header file for the frozen table with minimal perfect hashing.
+ *
+ * The table is built once from a finished ht_table_t and then it can only be
+ * searched. Every key gets its own slot and there are exactly as many slots
+ * as keys (minimal perfect hash, CHD algorithm): the key is hashed once, the
+ * hash selects a small bucket of keys, and the displacement found for the
+ * bucket at build time turns the hash into the slot. A lookup is one string
+ * hash, a few multiplications and one comparison of keys.
+ */
+
+#ifndef IAL_HASHTABLE_MPH_H
+#define IAL_HASHTABLE_MPH_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Average number of keys per bucket of displacements
+#define HT_MPH_BUCKET_SIZE 5
+
+// Maximum displacement tried for one bucket before another seed is tried
+#define HT_MPH_MAX_DISPLACEMENT (1 << 20)
+
+// Number of seeds tried by ht_mph_build
+#define HT_MPH_ATTEMPTS 16
+
+// Slot of the table
+typedef struct ht_mph_item {
+  char *key;     // key of the item (not copied from the source table)
+  float value;   // value of the item
+  uint64_t hash; // full hash of the key
+} ht_mph_item_t;
+
+// Frozen table
+typedef struct ht_mph_table {
+  ht_mph_item_t *items;    // slots (exactly count of them)
+  uint32_t *displacements; // displacement of every bucket
+  uint32_t count;          // number of items
+  uint32_t bucket_count;   // number of buckets of displacements
+  uint64_t seed;           // seed of the hash function
+} ht_mph_table_t;
+
+bool ht_mph_build(ht_mph_table_t *mph, ht_table_t *table);
+ht_mph_item_t *ht_mph_search(ht_mph_table_t *mph, char *key);
+float *ht_mph_get(ht_mph_table_t *mph, char *key);
+void ht_mph_destroy(ht_mph_table_t *mph);
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * Insertion-ordered hash table (compact dictionary)
+ *
+ * Entries are appended to a dense array, the buckets and the lists of synonyms
+ * contain only 32-bit indexes into it. The array and the buckets have the same
+ * size, so the load factor never exceeds 1.
+ *
+ * Deletion unlinks the entry from its list and clears its key, the entry itself
+ * stays in the array. So deleting never moves any entry and a cursor stays
+ * valid even if the item it has just returned (or any other item) is deleted.
+ * When the array is full, the insertion either compacts it (if at least half
+ * of the entries are deleted) or moves the live entries into a twice bigger
+ * one; in both cases the order of the items is kept, but cursors and pointers
+ * to entries are invalidated. A new iteration compacts the array too if most of
+ * its entries are deleted, so iterating never costs more than twice the items.
+ */
+
+#include "ordered.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline uint64_t ord_hash(ht_ord_table_t *table, const char *key) {
+    return table->hash(key, strlen(key), table->seed);
+}
+
+/*
+ * Returns the bucket of the hash.
+ */
+static inline int32_t *ord_bucket(ht_ord_table_t *table, uint64_t hash) {
+    return &table->buckets[hash & (table->size - 1)];
+}
+
+/*
+ * Returns pointer to the link (bucket or next field of the previous synonym)
+ * leading to the entry with the key. The link contains HT_ORD_NONE if there is
+ * no such entry.
+ */
+static int32_t *ord_find(ht_ord_table_t *table, char *key, uint64_t hash) {
+    int32_t *link = ord_bucket(table, hash);
+    while (*link != HT_ORD_NONE) {
+        ht_ord_entry_t *entry = &table->entries[*link];
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            break;
+        }
+        link = &entry->next;
+    }
+
+    return link;
+}
+
+/*
+ * Moves the live entries (in their order) to the beginning of an array with
+ * the given size and links them into new buckets. Returns false if there is
+ * not enough memory (table isn't changed).
+ */
+static bool ord_rebuild(ht_ord_table_t *table, size_t size) {
+    ht_ord_entry_t *entries = table->entries;
+    int32_t *buckets = table->buckets;
+    if (size != table->size) {
+        // Entries and buckets share one allocation
+        if ((entries = malloc(size * (sizeof(ht_ord_entry_t) + sizeof(int32_t)))) == NULL) {
+            return false;
+        }
+        buckets = (int32_t *) (entries + size);
+    }
+
+    // Entry is never moved to a higher index, so the array can be compacted in place
+    size_t used = 0;
+    for (size_t i = 0; i < table->used; i++) {
+        if (table->entries[i].key != NULL) {
+            entries[used++] = table->entries[i];
+        }
+    }
+
+    if (entries != table->entries) {
+        free(table->entries);
+    }
+
+    table->entries = entries;
+    table->buckets = buckets;
+    table->size = size;
+    table->used = used;
+
+    for (size_t i = 0; i < size; i++) {
+        buckets[i] = HT_ORD_NONE;
+    }
+    for (size_t i = 0; i < used; i++) {
+        int32_t *bucket = ord_bucket(table, entries[i].hash);
+        entries[i].next = *bucket;
+        *bucket = (int32_t) i;
+    }
+
+    return true;
+}
+
+/*
+ * Initialization of the table — call it before the first usage of the table.
+ * No memory is allocated until the first item is inserted.
+ */
+void ht_ord_init(ht_ord_table_t *table) {
+    table->buckets = NULL;
+    table->entries = NULL;
+    table->size = 0;
+    table->used = 0;
+    table->count = 0;
+    table->hash = ht_hash_wy;
+    table->seed = ht_hash_random_seed();
+}
+
+/*
+ * Changes hash function and seed of the table.
+ *
+ * It can be done only while the table is empty. Returns true if the function
+ * has been changed.
+ */
+bool ht_ord_set_hash(ht_ord_table_t *table, ht_hash_fn_t hash, uint64_t seed) {
+    if (table->count != 0) {
+        return false;
+    }
+
+    table->hash = hash;
+    table->seed = seed;
+
+    return true;
+}
+
+/*
+ * Searching for an item in the table.
+ *
+ * Returns pointer to the entry of the item or NULL if there is no item with
+ * the key. The pointer is valid until the next insertion into the table.
+ */
+ht_ord_entry_t *ht_ord_search(ht_ord_table_t *table, char *key) {
+    if (table->size == 0) {
+        return NULL;
+    }
+
+    int32_t index = *ord_find(table, key, ord_hash(table, key));
+
+    return index != HT_ORD_NONE ? &table->entries[index] : NULL;
+}
+
+/*
+ * Inserting a new item into the table.
+ *
+ * If there already is an item with the key, only its value is replaced and the
+ * item keeps its position in the order. New item is appended after all the
+ * other items.
+ */
+void ht_ord_insert(ht_ord_table_t *table, char *key, float value) {
+    uint64_t hash = ord_hash(table, key);
+    if (table->size != 0) {
+        int32_t index = *ord_find(table, key, hash);
+        if (index != HT_ORD_NONE) {
+            // Item is already in the table --> only change its value
+            table->entries[index].value = value;
+
+            return;
+        }
+    }
+
+    if (table->used == table->size) {
+        // Compact the array if it is mostly deleted entries, otherwise grow it
+        size_t size = table->size == 0 ? HT_ORD_INITIAL_SIZE : table->size;
+        if (table->count * 2 > table->size) {
+            size *= 2;
+        }
+
+        if (size > (size_t) INT32_MAX || !ord_rebuild(table, size)) {
+            return;
+        }
+    }
+
+    int32_t *bucket = ord_bucket(table, hash);
+    ht_ord_entry_t *entry = &table->entries[table->used];
+    entry->key = key;
+    entry->value = value;
+    entry->next = *bucket;
+    entry->hash = hash;
+    *bucket = (int32_t) table->used;
+
+    table->used++;
+    table->count++;
+}
+
+/*
+ * Getting value of the item from the table.
+ *
+ * Returns pointer to the value of the item or NULL if there is no item with the
+ * key.
+ */
+float *ht_ord_get(ht_ord_table_t *table, char *key) {
+    ht_ord_entry_t *entry;
+    if ((entry = ht_ord_search(table, key)) != NULL) {
+        return &entry->value;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Deleting an item from the table.
+ *
+ * The entry is only unlinked and marked as deleted, no other entry is moved.
+ * If there is no item with the key, nothing happens.
+ */
+void ht_ord_delete(ht_ord_table_t *table, char *key) {
+    if (table->size == 0) {
+        return;
+    }
+
+    int32_t *link = ord_find(table, key, ord_hash(table, key));
+    if (*link == HT_ORD_NONE) {
+        return;
+    }
+
+    ht_ord_entry_t *entry = &table->entries[*link];
+    *link = entry->next;
+    entry->key = NULL;
+    entry->next = HT_ORD_NONE;
+
+    table->count--;
+}
+
+/*
+ * Deleting all items from the table.
+ *
+ * All allocated resources are released and the table is in the same state as
+ * after the initialization (hash function and seed are kept).
+ */
+void ht_ord_delete_all(ht_ord_table_t *table) {
+    free(table->entries);
+
+    table->buckets = NULL;
+    table->entries = NULL;
+    table->size = 0;
+    table->used = 0;
+    table->count = 0;
+}
+
+/*
+ * Compacting the table.
+ *
+ * Deleted entries are dropped, so an iteration passes only the live items.
+ * The order of the items is kept, but cursors and pointers to entries are
+ * invalidated.
+ */
+void ht_ord_compact(ht_ord_table_t *table) {
+    if (table->used != table->count) {
+        // Array of the same size is compacted in place, it can't fail
+        ord_rebuild(table, table->size);
+    }
+}
+
+/*
+ * Sets the cursor before the first item of the table.
+ *
+ * If the deleted entries outnumber the items, the table is compacted first, so
+ * an iteration takes time proportional to the number of items even if no
+ * insertion has compacted the table after the deletions. Like an insertion,
+ * it invalidates other cursors and pointers to entries then.
+ */
+void ht_ord_cursor_init(ht_ord_table_t *table, ht_ord_cursor_t *cursor) {
+    if (table->used - table->count > table->count) {
+        ht_ord_compact(table);
+    }
+
+    cursor->index = 0;
+}
+
+/*
+ * Returns the next item of the iteration (in the order of insertion) and moves
+ * the cursor behind it. Returns NULL when there are no more items.
+ *
+ * Items can be deleted during the iteration (including the returned one), the
+ * deleted items which haven't been visited yet are skipped. Items inserted
+ * during the iteration are visited at its end, but an insertion can also
+ * compact or grow the table, after which the cursor must not be used anymore.
+ * Iteration passes the entries deleted since the cursor was initialized too
+ * (and the older ones if they don't outnumber the items).
+ */
+ht_ord_entry_t *ht_ord_next(ht_ord_table_t *table, ht_ord_cursor_t *cursor) {
+    while (cursor->index < table->used) {
+        ht_ord_entry_t *entry = &table->entries[cursor->index++];
+        if (entry->key != NULL) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
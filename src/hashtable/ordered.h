@@ -0,0 +1,63 @@
+/*
+ * Header file for the insertion-ordered hash table (compact dictionary).
+ *
+ * Items are stored in a dense array of entries in the order of their
+ * insertion; the buckets only hold indexes of the first entries of the lists
+ * of synonyms (lists are linked by indexes too). Iteration walks the entries,
+ * so it takes time proportional to the number of items, not buckets. Deleted
+ * entries are only marked until the array is compacted by an insertion or by
+ * the start of an iteration.
+ */
+
+#ifndef IAL_HASHTABLE_ORDERED_H
+#define IAL_HASHTABLE_ORDERED_H
+
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of entries allocated by the first insertion (power of two)
+#define HT_ORD_INITIAL_SIZE 8
+
+// End of a list of synonyms
+#define HT_ORD_NONE ((int32_t)-1)
+
+// Entry of the table, deleted entries have NULL key
+typedef struct ht_ord_entry {
+  char *key;     // key of the item
+  float value;   // value of the item
+  int32_t next;  // index of the next synonym or HT_ORD_NONE
+  uint64_t hash; // full hash of the key
+} ht_ord_entry_t;
+
+// Insertion-ordered table
+typedef struct ht_ord_table {
+  int32_t *buckets;        // indexes of the first entries of the lists
+  ht_ord_entry_t *entries; // entries in the order of insertion
+  size_t size;             // number of buckets and entries allocated
+  size_t used;             // number of used entries (including deleted)
+  size_t count;            // number of stored items
+  ht_hash_fn_t hash;       // hash function
+  uint64_t seed;           // seed of the hash function
+} ht_ord_table_t;
+
+// Position of an iteration over the table
+typedef struct ht_ord_cursor {
+  size_t index; // index of the next entry to visit
+} ht_ord_cursor_t;
+
+void ht_ord_init(ht_ord_table_t *table);
+ht_ord_entry_t *ht_ord_search(ht_ord_table_t *table, char *key);
+void ht_ord_insert(ht_ord_table_t *table, char *key, float value);
+float *ht_ord_get(ht_ord_table_t *table, char *key);
+void ht_ord_delete(ht_ord_table_t *table, char *key);
+void ht_ord_delete_all(ht_ord_table_t *table);
+
+bool ht_ord_set_hash(ht_ord_table_t *table, ht_hash_fn_t hash, uint64_t seed);
+void ht_ord_compact(ht_ord_table_t *table);
+
+void ht_ord_cursor_init(ht_ord_table_t *table, ht_ord_cursor_t *cursor);
+ht_ord_entry_t *ht_ord_next(ht_ord_table_t *table, ht_ord_cursor_t *cursor);
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * Tabuľka s rozptýlenými položkami
+ *
+ * Alternative implementation of hashtable.h with open addressing: items are
+ * stored directly in the HT_SIZE slots of ht_table_t (linear probing, no lists
+ * of synonyms, next pointers are always NULL), so the table can hold at most
+ * HT_SIZE items.
+ *
+ * Robin Hood insertion: an item which is further from its home slot takes
+ * the slot of an item which is closer to its own home slot, and the latter one
+ * continues probing. So the probe lengths of all items are similar even for
+ * load factors over 90 %, and a lookup can stop as soon as it meets an item
+ * closer to its home than the searched key would be.
+ *
+ * Deletion shifts the following items of the cluster one slot back (until an
+ * empty slot or an item in its home slot), so there are no tombstones and
+ * deletions don't make later lookups longer.
+ */
+
+#include "../hashtable.h"
+#include "../hash.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int HT_SIZE = MAX_HT_SIZE;
+
+/*
+ * Full (not reduced) hash of the key, items remember it.
+ */
+static uint64_t get_full_hash(char *key) {
+    return ht_hash_function(key, strlen(key), ht_hash_seed);
+}
+
+/*
+ * Returns the slot following the given one (probing wraps around).
+ */
+static inline int robin_next(int slot) {
+    return slot + 1 == HT_SIZE ? 0 : slot + 1;
+}
+
+/*
+ * Returns distance of the slot from the home slot of the hash.
+ */
+static inline int robin_distance(int slot, uint64_t hash) {
+    int distance = slot - (int) (hash % (uint64_t) HT_SIZE);
+
+    return distance < 0 ? distance + HT_SIZE : distance;
+}
+
+/*
+ * Finds the slot of the item with the key. Returns -1 if there is no such item,
+ * then the slot where the probing stopped (the slot for the key) is stored to
+ * stop (if it isn't NULL).
+ */
+static int robin_find(ht_table_t *table, char *key, uint64_t hash, int *stop) {
+    int slot = (int) (hash % (uint64_t) HT_SIZE);
+    for (int distance = 0; distance < HT_SIZE; distance++) {
+        ht_item_t *item = (*table)[slot];
+        if (item == NULL || robin_distance(slot, item->hash) < distance) {
+            // The key would have taken this slot when it was inserted
+            break;
+        }
+
+        if (item->hash == hash && strcmp(item->key, key) == 0) {
+            return slot;
+        }
+
+        slot = robin_next(slot);
+    }
+
+    if (stop != NULL) {
+        *stop = slot;
+    }
+
+    return -1;
+}
+
+/*
+ * Rozptyľovacia funkcia ktorá pridelí zadanému kľúču index z intervalu
+ * <0,HT_SIZE-1>. Ideálna rozptyľovacia funkcia by mala rozprestrieť kľúče
+ * rovnomerne po všetkých indexoch. Zamyslite sa nad kvalitou zvolenej funkcie.
+ */
+int get_hash(char *key) {
+    return (int) (get_full_hash(key) % (uint64_t) HT_SIZE);
+}
+
+/*
+ * Inicializácia tabuľky — zavolá sa pred prvým použitím tabuľky.
+ */
+void ht_init(ht_table_t *table) {
+    for (int i = 0; i < HT_SIZE; i++) {
+        (*table)[i] = NULL;
+    }
+}
+
+/*
+ * Vyhľadanie prvku v tabuľke.
+ *
+ * V prípade úspechu vráti ukazovateľ na nájdený prvok; v opačnom prípade vráti
+ * hodnotu NULL.
+ */
+ht_item_t *ht_search(ht_table_t *table, char *key) {
+    int slot = robin_find(table, key, get_full_hash(key), NULL);
+
+    return slot != -1 ? (*table)[slot] : NULL;
+}
+
+/*
+ * Vloženie nového prvku do tabuľky.
+ *
+ * Pokiaľ prvok s daným kľúčom už v tabuľke existuje, nahraďte jeho hodnotu.
+ *
+ * If the table is full (every slot is used), the new item isn't inserted.
+ */
+void ht_insert(ht_table_t *table, char *key, float value) {
+    uint64_t hash = get_full_hash(key);
+    int slot;
+    int found = robin_find(table, key, hash, &slot);
+    if (found != -1) {
+        // Item is already in the table --> only change its value
+        (*table)[found]->value = value;
+
+        return;
+    }
+
+    // The cluster continuing from the slot for the key has to end by an empty slot
+    int free_slot = slot;
+    for (int i = 0; (*table)[free_slot] != NULL; i++) {
+        if (i == HT_SIZE) {
+            return;
+        }
+        free_slot = robin_next(free_slot);
+    }
+
+    ht_item_t *new_item;
+    if ((new_item = malloc(sizeof(ht_item_t))) == NULL) {
+        return;
+    }
+
+    new_item->key = key;
+    new_item->value = value;
+    new_item->next = NULL;
+    new_item->hash = hash;
+
+    // Take slots from items closer to their home slots than the carried item
+    // (items before the slot for the key are not closer to their home slots)
+    ht_item_t *carried = new_item;
+    int distance = robin_distance(slot, hash);
+    while ((*table)[slot] != NULL) {
+        int resident_distance = robin_distance(slot, (*table)[slot]->hash);
+        if (resident_distance < distance) {
+            ht_item_t *resident = (*table)[slot];
+            (*table)[slot] = carried;
+            carried = resident;
+            distance = resident_distance;
+        }
+
+        slot = robin_next(slot);
+        distance++;
+    }
+
+    (*table)[slot] = carried;
+}
+
+/*
+ * Získanie hodnoty z tabuľky.
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na hodnotu prvku, v opačnom
+ * prípade hodnotu NULL.
+ */
+float *ht_get(ht_table_t *table, char *key) {
+    ht_item_t *item;
+    if ((item = ht_search(table, key)) != NULL) {
+        return &item->value;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Zmazanie prvku z tabuľky.
+ *
+ * Funkcia korektne uvoľní všetky alokované zdroje priradené k danému prvku.
+ * Pokiaľ prvok neexistuje, nerobte nič.
+ */
+void ht_delete(ht_table_t *table, char *key) {
+    int slot = robin_find(table, key, get_full_hash(key), NULL);
+    if (slot == -1) {
+        return;
+    }
+
+    free((*table)[slot]);
+
+    // Shift back the following items until one is in its home slot (or the slot is empty)
+    int next = robin_next(slot);
+    while ((*table)[next] != NULL && robin_distance(next, (*table)[next]->hash) > 0) {
+        (*table)[slot] = (*table)[next];
+        slot = next;
+        next = robin_next(next);
+    }
+
+    (*table)[slot] = NULL;
+}
+
+/*
+ * Zmazanie všetkých prvkov z tabuľky.
+ *
+ * Funkcia korektne uvoľní všetky alokované zdroje a uvedie tabuľku do stavu po
+ * inicializácii.
+ */
+void ht_delete_all(ht_table_t *table) {
+    for (int i = 0; i < HT_SIZE; i++) {
+        free((*table)[i]);
+        (*table)[i] = NULL;
+    }
+}
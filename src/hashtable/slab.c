@@ -0,0 +1,79 @@
+/*
+ * Slab allocator of hash table items
+ *
+ * Allocation takes an item from the free list, or the next unused item of the
+ * newest slab. Only when both are exhausted, a new slab is allocated. Slabs
+ * grow geometrically up to HT_SLAB_MAX_ITEMS, so there are only a few of them
+ * even for big tables.
+ */
+
+#include "slab.h"
+#include <stdlib.h>
+
+/*
+ * Initialization of the pool — no memory is allocated until the first item
+ * is needed. Item size must be a multiple of the alignment of ht_item_t.
+ */
+void ht_slab_init(ht_slab_pool_t *pool, size_t item_size) {
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->slab_count = 0;
+    pool->item_size = item_size;
+}
+
+/*
+ * Allocates an item. Returns NULL if there is not enough memory.
+ */
+ht_item_t *ht_slab_alloc(ht_slab_pool_t *pool) {
+    if (pool->free_list != NULL) {
+        // Reuse released item
+        ht_item_t *item = pool->free_list;
+        pool->free_list = item->next;
+
+        return item;
+    }
+
+    if (pool->slabs == NULL || pool->slabs->used == pool->slabs->capacity) {
+        // All items are used --> allocate a new (bigger) slab
+        size_t capacity = pool->slabs == NULL ? HT_SLAB_MIN_ITEMS : pool->slabs->capacity * 2;
+        if (capacity > HT_SLAB_MAX_ITEMS) {
+            capacity = HT_SLAB_MAX_ITEMS;
+        }
+
+        ht_slab_t *slab;
+        if ((slab = malloc(sizeof(ht_slab_t) + capacity * pool->item_size)) == NULL) {
+            return NULL;
+        }
+
+        slab->next = pool->slabs;
+        slab->capacity = capacity;
+        slab->used = 0;
+        pool->slabs = slab;
+        pool->slab_count++;
+    }
+
+    return (ht_item_t *) ((char *) pool->slabs->items + pool->slabs->used++ * pool->item_size);
+}
+
+/*
+ * Returns the item to the pool, so it can be reused by the next allocation.
+ */
+void ht_slab_free(ht_slab_pool_t *pool, ht_item_t *item) {
+    item->next = pool->free_list;
+    pool->free_list = item;
+}
+
+/*
+ * Releases all the slabs (and so all the items allocated from the pool).
+ * The pool is in the same state as after the initialization.
+ */
+void ht_slab_release(ht_slab_pool_t *pool) {
+    ht_slab_t *slab = pool->slabs;
+    while (slab != NULL) {
+        ht_slab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    ht_slab_init(pool, pool->item_size);
+}
@@ -0,0 +1,45 @@
+/*
+ * Header file for the slab allocator of hash table items.
+ *
+ * Items are allocated from big blocks (slabs) owned by one table. Released
+ * items are kept in a free list and reused by next allocations. All the items
+ * are released at once by releasing the slabs.
+ *
+ * Items can be bigger than ht_item_t (tables can append their own data to
+ * it), all the items of one pool have the same size.
+ */
+
+#ifndef IAL_HASHTABLE_SLAB_H
+#define IAL_HASHTABLE_SLAB_H
+
+#include "hashtable.h"
+#include <stddef.h>
+
+// Number of items in the first slab (next slabs are twice bigger)
+#define HT_SLAB_MIN_ITEMS 64
+
+// Maximum number of items in one slab
+#define HT_SLAB_MAX_ITEMS 65536
+
+// Block of items
+typedef struct ht_slab {
+  struct ht_slab *next; // previously allocated slab
+  size_t capacity;      // number of items in the slab
+  size_t used;          // number of items already handed out
+  ht_item_t items[];    // items (with stride of the pool's item size)
+} ht_slab_t;
+
+// Allocator of items for one table
+typedef struct ht_slab_pool {
+  ht_slab_t *slabs;     // the newest slab (others are linked from it)
+  ht_item_t *free_list; // released items linked by their next pointers
+  size_t slab_count;    // number of allocated slabs
+  size_t item_size;     // size of one item (at least sizeof(ht_item_t))
+} ht_slab_pool_t;
+
+void ht_slab_init(ht_slab_pool_t *pool, size_t item_size);
+ht_item_t *ht_slab_alloc(ht_slab_pool_t *pool);
+void ht_slab_free(ht_slab_pool_t *pool, ht_item_t *item);
+void ht_slab_release(ht_slab_pool_t *pool);
+
+#endif
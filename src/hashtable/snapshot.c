@@ -0,0 +1,322 @@
+/*
+ * Snapshots of hash tables
+ *
+ * The writer lays out the table again instead of dumping ht_dyn_table_t: the
+ * number of buckets is the smallest power of two not lower than the number of
+ * items, and the items of every bucket are stored in one run, so a lookup in
+ * the mapping reads one bucket index pair and a few consecutive items.
+ */
+
+#include "snapshot.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Returns hash of the key as stored in the snapshot.
+ */
+static inline uint64_t snap_hash(const char *key, size_t length, uint64_t seed) {
+    return ht_hash_wy(key, length, seed);
+}
+
+/*
+ * Calls the function for every item of the table (in both bucket arrays if the
+ * table is being rehashed).
+ */
+static void snap_for_each(ht_dyn_table_t *table, void (*function)(ht_item_t *item, void *data), void *data) {
+    ht_item_t **arrays[] = {table->old_buckets, table->buckets};
+    size_t sizes[] = {table->old_size, table->size};
+
+    for (int i = 0; i < 2; i++) {
+        for (size_t j = 0; j < sizes[i] && arrays[i] != NULL; j++) {
+            for (ht_item_t *item = arrays[i][j]; item != NULL; item = item->next) {
+                function(item, data);
+            }
+        }
+    }
+}
+
+// State of the writer shared by the callbacks of snap_for_each
+typedef struct snap_writer {
+    ht_dyn_table_t *table;
+    uint64_t mask;
+    uint64_t *buckets;
+    uint64_t *next;
+    ht_snap_item_t *items;
+    uint64_t strings_length;
+    FILE *file;
+} snap_writer_t;
+
+/*
+ * Returns hash of the item for the snapshot.
+ */
+static uint64_t snap_item_hash(snap_writer_t *writer, ht_item_t *item) {
+    ht_dyn_table_t *table = writer->table;
+    if (table->hash == ht_hash_wy && !(table->flags & HT_DYN_INTERNED)) {
+        // Stored hash has been computed by the same function
+        return item->hash;
+    }
+
+    return snap_hash(item->key, strlen(item->key), table->seed);
+}
+
+/*
+ * Counts the item into its bucket (stored one place further, see below).
+ */
+static void snap_count_item(ht_item_t *item, void *data) {
+    snap_writer_t *writer = data;
+    writer->buckets[(snap_item_hash(writer, item) & writer->mask) + 1]++;
+}
+
+/*
+ * Stores the item to the next free place of its bucket.
+ */
+static void snap_place_item(ht_item_t *item, void *data) {
+    snap_writer_t *writer = data;
+    uint64_t hash = snap_item_hash(writer, item);
+    ht_snap_item_t *placed = &writer->items[writer->next[hash & writer->mask]++];
+
+    placed->hash = hash;
+    placed->key = writer->strings_length;
+    placed->length = (uint32_t) strlen(item->key);
+    placed->value = item->value;
+    writer->strings_length += placed->length + 1;
+}
+
+/*
+ * Writes the key of the item into the file.
+ */
+static void snap_write_key(ht_item_t *item, void *data) {
+    snap_writer_t *writer = data;
+    fwrite(item->key, 1, strlen(item->key) + 1, writer->file);
+}
+
+/*
+ * Writes snapshot of the table into the file (an existing file is replaced).
+ *
+ * Returns false if the file can't be written or there is not enough memory.
+ */
+bool ht_snap_write(ht_dyn_table_t *table, const char *path) {
+    uint64_t size = 1;
+    while (size < table->count) {
+        size *= 2;
+    }
+
+    snap_writer_t writer = {table, size - 1, NULL, NULL, NULL, 0, NULL};
+    writer.buckets = calloc(size + 1, sizeof(uint64_t));
+    writer.next = malloc(size * sizeof(uint64_t));
+    writer.items = malloc((table->count > 0 ? table->count : 1) * sizeof(ht_snap_item_t));
+    if (writer.buckets == NULL || writer.next == NULL || writer.items == NULL) {
+        free(writer.buckets);
+        free(writer.next);
+        free(writer.items);
+        return false;
+    }
+
+    // Count items of the buckets, then turn the counts into first indexes
+    snap_for_each(table, snap_count_item, &writer);
+    for (uint64_t i = 0; i < size; i++) {
+        writer.buckets[i + 1] += writer.buckets[i];
+        writer.next[i] = writer.buckets[i];
+    }
+    snap_for_each(table, snap_place_item, &writer);
+
+    ht_snap_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HT_SNAP_MAGIC, sizeof(header.magic));
+    header.version = HT_SNAP_VERSION;
+    header.byte_order = HT_SNAP_BYTE_ORDER;
+    header.seed = table->seed;
+    header.size = size;
+    header.count = table->count;
+    header.buckets = sizeof(ht_snap_header_t);
+    header.items = header.buckets + (size + 1) * sizeof(uint64_t);
+    header.strings = header.items + table->count * sizeof(ht_snap_item_t);
+    header.length = header.strings + writer.strings_length;
+
+    bool written = false;
+    if ((writer.file = fopen(path, "wb")) != NULL) {
+        fwrite(&header, sizeof(header), 1, writer.file);
+        fwrite(writer.buckets, sizeof(uint64_t), size + 1, writer.file);
+        fwrite(writer.items, sizeof(ht_snap_item_t), table->count, writer.file);
+
+        // Keys are written in the same order as their offsets were assigned
+        snap_for_each(table, snap_write_key, &writer);
+
+        written = !ferror(writer.file);
+        written = fclose(writer.file) == 0 && written;
+    }
+
+    free(writer.buckets);
+    free(writer.next);
+    free(writer.items);
+
+    return written;
+}
+
+/*
+ * Checks that the header describes a snapshot of the same length as the file.
+ * The sections themselves are trusted (they're written by ht_snap_write).
+ */
+static bool snap_valid(const ht_snap_header_t *header, size_t length) {
+    return memcmp(header->magic, HT_SNAP_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == HT_SNAP_VERSION && header->byte_order == HT_SNAP_BYTE_ORDER &&
+           header->size != 0 && (header->size & (header->size - 1)) == 0 &&
+           header->buckets == sizeof(ht_snap_header_t) &&
+           header->items == header->buckets + (header->size + 1) * sizeof(uint64_t) &&
+           header->strings == header->items + header->count * sizeof(ht_snap_item_t) &&
+           header->strings <= length && header->length == length;
+}
+
+/*
+ * Opens the snapshot by mapping the file into memory.
+ *
+ * Returns false if the file can't be mapped or it isn't a valid snapshot.
+ */
+bool ht_snap_open(ht_snap_t *snap, const char *path) {
+    memset(snap, 0, sizeof(*snap));
+
+    int fd;
+    if ((fd = open(path, O_RDONLY)) == -1) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(ht_snap_header_t)) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the file is closed
+    void *map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    snap->map = map;
+    snap->length = (size_t) info.st_size;
+    snap->header = map;
+    if (!snap_valid(snap->header, snap->length) ||
+        ((const uint64_t *) (snap->map + snap->header->buckets))[snap->header->size] != snap->header->count) {
+        ht_snap_close(snap);
+        return false;
+    }
+
+    snap->buckets = (const uint64_t *) (snap->map + snap->header->buckets);
+    snap->items = (const ht_snap_item_t *) (snap->map + snap->header->items);
+    snap->strings = (const char *) (snap->map + snap->header->strings);
+
+    return true;
+}
+
+/*
+ * Closes the snapshot: the copy (if any) is deleted and the file is unmapped.
+ */
+void ht_snap_close(ht_snap_t *snap) {
+    if (snap->copied) {
+        ht_dyn_delete_all(&snap->copy);
+    }
+
+    if (snap->map != NULL) {
+        munmap((void *) snap->map, snap->length);
+    }
+
+    memset(snap, 0, sizeof(*snap));
+}
+
+/*
+ * Makes the modifiable copy of the snapshot. Items are inserted with their
+ * stored hashes, so no key is hashed again. Returns false if there is not
+ * enough memory (the snapshot is still served from the file then).
+ */
+static bool snap_copy(ht_snap_t *snap) {
+    if (snap->copied) {
+        return true;
+    }
+
+    ht_dyn_init(&snap->copy);
+    ht_dyn_set_hash(&snap->copy, ht_hash_wy, snap->header->seed);
+    for (uint64_t i = 0; i < snap->header->count; i++) {
+        const ht_snap_item_t *item = &snap->items[i];
+        ht_dyn_insert_hashed(&snap->copy, (char *) snap->strings + item->key, item->hash, item->value);
+    }
+
+    if (snap->copy.count != snap->header->count) {
+        ht_dyn_delete_all(&snap->copy);
+        return false;
+    }
+
+    snap->copied = true;
+
+    return true;
+}
+
+/*
+ * Getting value of the item from the snapshot.
+ *
+ * Returns pointer to the value of the item or NULL if there is no item with the
+ * key. The value can't be changed through the pointer (use ht_snap_insert) and
+ * the pointer is valid until the next modification.
+ */
+const float *ht_snap_get(ht_snap_t *snap, char *key) {
+    if (snap->copied) {
+        return ht_dyn_get(&snap->copy, key);
+    }
+
+    size_t length = strlen(key);
+    uint64_t hash = snap_hash(key, length, snap->header->seed);
+    uint64_t bucket = hash & (snap->header->size - 1);
+
+    for (uint64_t i = snap->buckets[bucket]; i < snap->buckets[bucket + 1]; i++) {
+        const ht_snap_item_t *item = &snap->items[i];
+        if (item->hash == hash && item->length == length &&
+            memcmp(snap->strings + item->key, key, length) == 0) {
+            return &item->value;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Inserting an item into the snapshot (into its copy, the file isn't changed).
+ *
+ * The key isn't copied, it has to stay valid while the snapshot is open.
+ * Returns false if the copy can't be made.
+ */
+bool ht_snap_insert(ht_snap_t *snap, char *key, float value) {
+    if (!snap_copy(snap)) {
+        return false;
+    }
+
+    ht_dyn_insert(&snap->copy, key, value);
+
+    return true;
+}
+
+/*
+ * Deleting an item from the snapshot (from its copy, the file isn't changed).
+ *
+ * Returns false if the copy can't be made.
+ */
+bool ht_snap_delete(ht_snap_t *snap, char *key) {
+    if (!snap_copy(snap)) {
+        return false;
+    }
+
+    ht_dyn_delete(&snap->copy, key);
+
+    return true;
+}
+
+/*
+ * Returns number of items in the snapshot.
+ */
+size_t ht_snap_count(ht_snap_t *snap) {
+    return snap->copied ? snap->copy.count : (size_t) snap->header->count;
+}
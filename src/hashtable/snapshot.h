@@ -0,0 +1,80 @@
+/*
+ * Header file for snapshots of hash tables.
+ *
+ * A snapshot is a file with the whole table: header, bucket array, items and
+ * keys. It contains no pointers (only offsets and indexes), so it can be
+ * mapped into memory anywhere and searched directly in the mapping, without
+ * parsing or allocating anything.
+ *
+ * Items of one bucket are stored next to each other; the bucket array holds
+ * index of the first item of every bucket (and the total count at the end),
+ * so the items of bucket b are items[buckets[b]] .. items[buckets[b + 1] - 1].
+ * Keys are hashed by ht_hash_wy with the seed from the header.
+ *
+ * The mapping is read-only. The first modification copies the snapshot into
+ * an ht_dyn_table_t (keys aren't copied, they point into the mapping) and all
+ * the following operations use the copy. The file itself never changes.
+ */
+
+#ifndef IAL_HASHTABLE_SNAPSHOT_H
+#define IAL_HASHTABLE_SNAPSHOT_H
+
+#include "dyn_table.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Identification of snapshot files
+#define HT_SNAP_MAGIC "IALHTSNP"
+
+// Version of the file format
+#define HT_SNAP_VERSION 1
+
+// Written in the byte order of the writer, read back the same only by readers
+// with the same byte order
+#define HT_SNAP_BYTE_ORDER 0x01020304
+
+// Header of the file (offsets are from the start of the file)
+typedef struct ht_snap_header {
+  char magic[8];       // HT_SNAP_MAGIC (without the terminating zero)
+  uint32_t version;    // HT_SNAP_VERSION
+  uint32_t byte_order; // HT_SNAP_BYTE_ORDER
+  uint64_t seed;       // seed of ht_hash_wy
+  uint64_t size;       // number of buckets (power of two)
+  uint64_t count;      // number of items
+  uint64_t buckets;    // offset of the bucket array (size + 1 indexes)
+  uint64_t items;      // offset of the item array
+  uint64_t strings;    // offset of the keys
+  uint64_t length;     // length of the whole file
+} ht_snap_header_t;
+
+// Item of the file
+typedef struct ht_snap_item {
+  uint64_t hash;   // full hash of the key
+  uint64_t key;    // offset of the key from the start of the keys
+  uint32_t length; // length of the key (without the terminating zero)
+  float value;     // value of the item
+} ht_snap_item_t;
+
+// Opened snapshot
+typedef struct ht_snap {
+  const unsigned char *map;       // mapping of the file
+  size_t length;                  // length of the mapping
+  const ht_snap_header_t *header; // header in the mapping
+  const uint64_t *buckets;        // bucket array in the mapping
+  const ht_snap_item_t *items;    // items in the mapping
+  const char *strings;            // keys in the mapping
+  bool copied;                    // operations use the copy instead of the file
+  ht_dyn_table_t copy;            // copy made by the first modification
+} ht_snap_t;
+
+bool ht_snap_write(ht_dyn_table_t *table, const char *path);
+bool ht_snap_open(ht_snap_t *snap, const char *path);
+void ht_snap_close(ht_snap_t *snap);
+
+const float *ht_snap_get(ht_snap_t *snap, char *key);
+bool ht_snap_insert(ht_snap_t *snap, char *key, float value);
+bool ht_snap_delete(ht_snap_t *snap, char *key);
+size_t ht_snap_count(ht_snap_t *snap);
+
+#endif
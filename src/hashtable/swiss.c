@@ -0,0 +1,292 @@
+/*
+ * Open addressing hash table (Swiss table style)
+ *
+ * The hash of the key is split into two parts: H1 (upper bits) selects the
+ * group of HT_SWISS_GROUP slots where the probing starts, H2 (low 7 bits) is
+ * stored into the control byte of the slot. Lookup compares H2 with all the
+ * control bytes of the group at once and calls strcmp only for the matching
+ * slots. Groups are probed in triangular sequence until a group with an EMPTY
+ * slot is found.
+ *
+ * Deleted slot becomes EMPTY if its group already contains an EMPTY slot (no
+ * probe sequence can go over such group), otherwise it becomes a tombstone.
+ * Tombstones are removed by rehashing when the table is too loaded.
+ */
+
+#include "swiss.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * Returns bit mask of the group slots whose control byte equals to value.
+ */
+static inline unsigned swiss_match(const int8_t *group, int8_t value) {
+#ifdef __SSE2__
+    __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HT_SWISS_GROUP; i++) {
+        mask |= (unsigned) (group[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+/*
+ * Returns bit mask of the group slots which are EMPTY or DELETED (both have
+ * the highest bit set, full slots don't).
+ */
+static inline unsigned swiss_match_free(const int8_t *group) {
+#ifdef __SSE2__
+    return (unsigned) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HT_SWISS_GROUP; i++) {
+        mask |= (unsigned) (group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+static inline uint64_t swiss_hash(ht_swiss_table_t *table, const char *key) {
+    return table->hash(key, strlen(key), table->seed);
+}
+
+static inline int8_t swiss_h2(uint64_t hash) {
+    return (int8_t) (hash & 0x7f);
+}
+
+static inline size_t swiss_first_group(ht_swiss_table_t *table, uint64_t hash) {
+    return (size_t) (hash >> 7) & (table->capacity / HT_SWISS_GROUP - 1);
+}
+
+/*
+ * Returns index of the first free slot in the probe sequence of the hash.
+ */
+static size_t swiss_find_free(ht_swiss_table_t *table, uint64_t hash) {
+    size_t groups_mask = table->capacity / HT_SWISS_GROUP - 1;
+    size_t group = swiss_first_group(table, hash);
+    for (size_t i = 1;; i++) {
+        unsigned mask = swiss_match_free(table->ctrl + group * HT_SWISS_GROUP);
+        if (mask != 0) {
+            return group * HT_SWISS_GROUP + (size_t) __builtin_ctz(mask);
+        }
+
+        // Triangular probing visits all the groups (their count is a power of two)
+        group = (group + i) & groups_mask;
+    }
+}
+
+/*
+ * Moves all the items into new arrays with the given capacity. Tombstones are
+ * dropped. Returns false if there is not enough memory (table isn't changed).
+ */
+static bool swiss_resize(ht_swiss_table_t *table, size_t capacity) {
+    // Slots and control bytes share one allocation
+    ht_swiss_item_t *items;
+    if ((items = malloc(capacity * (sizeof(ht_swiss_item_t) + 1))) == NULL) {
+        return false;
+    }
+
+    ht_swiss_item_t *old_items = table->items;
+    int8_t *old_ctrl = table->ctrl;
+    size_t old_capacity = table->capacity;
+
+    table->items = items;
+    table->ctrl = (int8_t *) (items + capacity);
+    table->capacity = capacity;
+    table->tombstones = 0;
+    memset(table->ctrl, (unsigned char) HT_SWISS_EMPTY, capacity);
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] >= 0) {
+            uint64_t hash = swiss_hash(table, old_items[i].key);
+            size_t slot = swiss_find_free(table, hash);
+            table->ctrl[slot] = swiss_h2(hash);
+            table->items[slot] = old_items[i];
+        }
+    }
+
+    free(old_items);
+
+    return true;
+}
+
+/*
+ * Finds the slot with the key. Returns its index or capacity if there is no
+ * such key.
+ */
+static size_t swiss_find(ht_swiss_table_t *table, char *key, uint64_t hash) {
+    size_t groups_mask = table->capacity / HT_SWISS_GROUP - 1;
+    size_t group = swiss_first_group(table, hash);
+    int8_t h2 = swiss_h2(hash);
+    for (size_t i = 1;; i++) {
+        const int8_t *ctrl = table->ctrl + group * HT_SWISS_GROUP;
+
+        // Only slots with the same H2 can contain the key
+        unsigned mask = swiss_match(ctrl, h2);
+        while (mask != 0) {
+            size_t slot = group * HT_SWISS_GROUP + (size_t) __builtin_ctz(mask);
+            if (strcmp(table->items[slot].key, key) == 0) {
+                return slot;
+            }
+            mask &= mask - 1;
+        }
+
+        if (swiss_match(ctrl, HT_SWISS_EMPTY) != 0) {
+            // The key would have been inserted into this group
+            return table->capacity;
+        }
+
+        group = (group + i) & groups_mask;
+    }
+}
+
+/*
+ * Initialization of the table — call it before the first usage of the table.
+ */
+void ht_swiss_init(ht_swiss_table_t *table) {
+    table->ctrl = NULL;
+    table->items = NULL;
+    table->capacity = 0;
+    table->count = 0;
+    table->tombstones = 0;
+    table->hash = ht_hash_wy;
+    table->seed = ht_hash_random_seed();
+}
+
+/*
+ * Changes hash function and seed of the table.
+ *
+ * It can be done only while the table is empty. Returns true if the function
+ * has been changed.
+ */
+bool ht_swiss_set_hash(ht_swiss_table_t *table, ht_hash_fn_t hash, uint64_t seed) {
+    if (table->count != 0) {
+        return false;
+    }
+
+    table->hash = hash;
+    table->seed = seed;
+
+    return true;
+}
+
+/*
+ * Searching for an item in the table.
+ *
+ * Returns pointer to the found item or NULL if there is no item with the key.
+ * The pointer is valid until the next insertion into the table.
+ */
+ht_swiss_item_t *ht_swiss_search(ht_swiss_table_t *table, char *key) {
+    if (table->capacity == 0) {
+        return NULL;
+    }
+
+    size_t slot = swiss_find(table, key, swiss_hash(table, key));
+
+    return slot != table->capacity ? &table->items[slot] : NULL;
+}
+
+/*
+ * Inserting a new item into the table.
+ *
+ * If there already is an item with the key, only its value is replaced.
+ */
+void ht_swiss_insert(ht_swiss_table_t *table, char *key, float value) {
+    uint64_t hash = swiss_hash(table, key);
+    if (table->capacity != 0) {
+        size_t slot = swiss_find(table, key, hash);
+        if (slot != table->capacity) {
+            // Item is already in the table --> only change its value
+            table->items[slot].value = value;
+
+            return;
+        }
+    }
+
+    if ((table->count + table->tombstones + 1) * 8 > table->capacity * HT_SWISS_MAX_LOAD) {
+        // Grow only if there are too many items, otherwise just drop tombstones
+        size_t capacity = table->capacity == 0 ? HT_SWISS_GROUP : table->capacity;
+        if ((table->count + 1) * 16 > capacity * HT_SWISS_MAX_LOAD) {
+            capacity *= 2;
+        }
+
+        if (!swiss_resize(table, capacity)) {
+            return;
+        }
+    }
+
+    size_t slot = swiss_find_free(table, hash);
+    if (table->ctrl[slot] == HT_SWISS_DELETED) {
+        table->tombstones--;
+    }
+
+    table->ctrl[slot] = swiss_h2(hash);
+    table->items[slot].key = key;
+    table->items[slot].value = value;
+    table->count++;
+}
+
+/*
+ * Getting value of the item from the table.
+ *
+ * Returns pointer to the value of the item or NULL if there is no item with the
+ * key.
+ */
+float *ht_swiss_get(ht_swiss_table_t *table, char *key) {
+    ht_swiss_item_t *item;
+    if ((item = ht_swiss_search(table, key)) != NULL) {
+        return &item->value;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Deleting an item from the table.
+ *
+ * If there is no item with the key, nothing happens.
+ */
+void ht_swiss_delete(ht_swiss_table_t *table, char *key) {
+    if (table->capacity == 0) {
+        return;
+    }
+
+    size_t slot = swiss_find(table, key, swiss_hash(table, key));
+    if (slot == table->capacity) {
+        return;
+    }
+
+    const int8_t *group = table->ctrl + (slot & ~(size_t) (HT_SWISS_GROUP - 1));
+    if (swiss_match(group, HT_SWISS_EMPTY) != 0) {
+        // No probe sequence continues behind this group
+        table->ctrl[slot] = HT_SWISS_EMPTY;
+    } else {
+        table->ctrl[slot] = HT_SWISS_DELETED;
+        table->tombstones++;
+    }
+
+    table->count--;
+}
+
+/*
+ * Deleting all items from the table.
+ *
+ * All allocated resources are released and the table is in the same state as
+ * after the initialization (hash function and seed are kept).
+ */
+void ht_swiss_delete_all(ht_swiss_table_t *table) {
+    free(table->items);
+
+    table->ctrl = NULL;
+    table->items = NULL;
+    table->capacity = 0;
+    table->count = 0;
+    table->tombstones = 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Header file for the open addressing hash table (Swiss table style).
+ *
+ * Items are stored directly in a flat array, there are no lists of synonyms.
+ * Every slot has a control byte in a separate array: either EMPTY, DELETED
+ * or low 7 bits of the hash of the stored key. Control bytes are compared by
+ * whole groups of HT_SWISS_GROUP slots at once (SSE2 if available), so most
+ * lookups touch one group of control bytes and one slot.
+ */
+
+#ifndef IAL_HASHTABLE_SWISS_H
+#define IAL_HASHTABLE_SWISS_H
+
+#include "hash.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of slots probed at once
+#define HT_SWISS_GROUP 16
+
+// Control byte of a never used slot
+#define HT_SWISS_EMPTY ((int8_t)-128)
+
+// Control byte of a slot with deleted item (tombstone)
+#define HT_SWISS_DELETED ((int8_t)-2)
+
+// Maximum load (used and deleted slots) in eighths of capacity
+#define HT_SWISS_MAX_LOAD 7
+
+// Item of the table
+typedef struct ht_swiss_item {
+  char *key;   // key of the item
+  float value; // value of the item
+} ht_swiss_item_t;
+
+// Open addressing table
+typedef struct ht_swiss_table {
+  int8_t *ctrl;            // control bytes of the slots
+  ht_swiss_item_t *items;  // slots
+  size_t capacity;         // number of slots (power of two, >= HT_SWISS_GROUP)
+  size_t count;            // number of stored items
+  size_t tombstones;       // number of DELETED slots
+  ht_hash_fn_t hash;       // hash function
+  uint64_t seed;           // seed of the hash function
+} ht_swiss_table_t;
+
+void ht_swiss_init(ht_swiss_table_t *table);
+ht_swiss_item_t *ht_swiss_search(ht_swiss_table_t *table, char *key);
+void ht_swiss_insert(ht_swiss_table_t *table, char *key, float value);
+float *ht_swiss_get(ht_swiss_table_t *table, char *key);
+void ht_swiss_delete(ht_swiss_table_t *table, char *key);
+void ht_swiss_delete_all(ht_swiss_table_t *table);
+
+bool ht_swiss_set_hash(ht_swiss_table_t *table, ht_hash_fn_t hash,
+                       uint64_t seed);
+
+#endif
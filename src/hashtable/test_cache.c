@@ -0,0 +1,158 @@
+#include "cache.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CACHE_TEST(NAME, DESCRIPTION, CAPACITY, POLICY)                        \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_cache_t test_cache;                                                     \
+    ht_cache_init(&test_cache, CAPACITY, POLICY);                              \
+    ht_cache_set_hash(&test_cache, ht_hash_wy, 0);
+
+#define END_CACHE_TEST                                                         \
+  printf("\n");                                                                \
+  ht_cache_print_summary(&test_cache);                                         \
+  ht_cache_destroy(&test_cache);                                               \
+  printf("\n");                                                                \
+  }
+
+void init_test() {
+  printf("Bounded Cache - testing script\n");
+  printf("------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void ht_cache_print_summary(ht_cache_t *cache) {
+  printf("------------------------------------\n");
+  printf("Cached items: %zu of %zu\n", cache->count, cache->capacity);
+  printf("Hits: %zu, misses: %zu\n", cache->counters.hits,
+         cache->counters.misses);
+  printf("Inserts: %zu, updates: %zu, evictions: %zu\n",
+         cache->counters.inserts, cache->counters.updates,
+         cache->counters.evictions);
+  printf("------------------------------------\n");
+}
+
+// Prints the cached test items (in the order of TEST_DATA)
+void ht_cache_print_items(ht_cache_t *cache) {
+  for (size_t i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {
+    float *value = ht_cache_peek(cache, TEST_DATA[i].key);
+    if (value != NULL) {
+      printf("(%s,%.2f)", TEST_DATA[i].key, *value);
+    }
+  }
+  printf("\n");
+}
+
+// Inserts the test items from first to last - 1 and prints the evicted keys
+void insert_test_data(ht_cache_t *cache, size_t first, size_t last) {
+  for (size_t i = first; i < last; i++) {
+    char *evicted = ht_cache_insert(cache, TEST_DATA[i].key, TEST_DATA[i].value);
+    if (evicted != NULL) {
+      printf("Evicted: %s\n", evicted);
+    }
+  }
+}
+
+CACHE_TEST(test_cache_init, "Initialize the cache", 4, HT_CACHE_CLOCK)
+ht_print_item_value(ht_cache_get(&test_cache, "Ethereum"));
+printf("Deleted: %s\n", ht_cache_delete(&test_cache, "Ethereum") ? "yes" : "no");
+END_CACHE_TEST
+
+CACHE_TEST(test_insert_many, "Insert more items than the capacity", 4,
+           HT_CACHE_LRU)
+insert_test_data(&test_cache, 0, 15);
+ht_cache_print_items(&test_cache);
+END_CACHE_TEST
+
+CACHE_TEST(test_lru_hit, "Hit protects an item (LRU)", 4, HT_CACHE_LRU)
+insert_test_data(&test_cache, 0, 4);
+ht_print_item_value(ht_cache_get(&test_cache, "Bitcoin"));
+ht_print_item_value(ht_cache_get(&test_cache, "Monero"));
+insert_test_data(&test_cache, 4, 6);
+ht_cache_print_items(&test_cache);
+END_CACHE_TEST
+
+CACHE_TEST(test_lru_update, "Update protects an item (LRU)", 4, HT_CACHE_LRU)
+insert_test_data(&test_cache, 0, 4);
+ht_cache_insert(&test_cache, "Bitcoin", 60000);
+ht_cache_insert(&test_cache, "Tether", 0.86);
+ht_cache_print_items(&test_cache);
+END_CACHE_TEST
+
+CACHE_TEST(test_clock_hit, "Hit gives a second chance (CLOCK)", 4,
+           HT_CACHE_CLOCK)
+insert_test_data(&test_cache, 0, 4);
+ht_print_item_value(ht_cache_get(&test_cache, "Bitcoin"));
+ht_print_item_value(ht_cache_get(&test_cache, "Cardano"));
+insert_test_data(&test_cache, 4, 7);
+ht_cache_print_items(&test_cache);
+END_CACHE_TEST
+
+CACHE_TEST(test_delete, "Deleted item makes room", 4, HT_CACHE_CLOCK)
+insert_test_data(&test_cache, 0, 4);
+printf("Deleted: %s\n", ht_cache_delete(&test_cache, "Ethereum") ? "yes" : "no");
+printf("Deleted: %s\n", ht_cache_delete(&test_cache, "Monero") ? "yes" : "no");
+ht_cache_insert(&test_cache, "Monero", 222.43);
+ht_cache_print_items(&test_cache);
+ht_print_item_value(ht_cache_peek(&test_cache, "Monero"));
+END_CACHE_TEST
+
+CACHE_TEST(test_many, "Keep the hot keys", 100, HT_CACHE_LRU)
+for (int round = 0; round < 10; round++) {
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    // Every tenth access is to one of five hot keys, other keys are cold
+    char *key = generated_keys[i % 10 == 0 ? (i / 10) % 5 * 10 : i];
+    if (ht_cache_get(&test_cache, key) == NULL) {
+      ht_cache_insert(&test_cache, key, (float)i);
+    }
+  }
+}
+int hot = 0;
+for (int i = 0; i < 50; i += 10) {
+  hot += ht_cache_peek(&test_cache, generated_keys[i]) != NULL;
+}
+printf("Hot keys cached: %d of 5\n", hot);
+END_CACHE_TEST
+
+CACHE_TEST(test_many_clock, "Keep the hot keys (CLOCK)", 100, HT_CACHE_CLOCK)
+for (int round = 0; round < 10; round++) {
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    char *key = generated_keys[i % 10 == 0 ? (i / 10) % 5 * 10 : i];
+    if (ht_cache_get(&test_cache, key) == NULL) {
+      ht_cache_insert(&test_cache, key, (float)i);
+    }
+  }
+}
+int hot = 0;
+for (int i = 0; i < 50; i += 10) {
+  hot += ht_cache_peek(&test_cache, generated_keys[i]) != NULL;
+}
+printf("Hot keys cached: %d of 5\n", hot);
+END_CACHE_TEST
+
+CACHE_TEST(test_delete_all, "Delete all the items", 4, HT_CACHE_LRU)
+insert_test_data(&test_cache, 0, 6);
+ht_cache_delete_all(&test_cache);
+ht_cache_print_items(&test_cache);
+insert_test_data(&test_cache, 6, 10);
+ht_cache_print_items(&test_cache);
+END_CACHE_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_cache_init();
+  test_insert_many();
+  test_lru_hit();
+  test_lru_update();
+  test_clock_hit();
+  test_delete();
+  test_many();
+  test_many_clock();
+  test_delete_all();
+}
@@ -0,0 +1,167 @@
+#include "conc_table.h"
+#include "test_util.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define THREADS 8
+#define KEYS_PER_THREAD 2000
+#define WORKER_KEYS (THREADS * KEYS_PER_THREAD)
+
+#define CONC_TEST(NAME, DESCRIPTION, SHARDS)                                   \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_conc_table_t test_table;                                                \
+    ht_conc_init(&test_table, SHARDS);                                         \
+    ht_conc_set_hash(&test_table, ht_hash_wy, 0);                              \
+    printf("Shards: %zu\n", test_table.shard_count);
+
+#define END_CONC_TEST                                                          \
+  printf("Items: %zu\n", ht_conc_count(&test_table));                          \
+  ht_conc_destroy(&test_table);                                                \
+  printf("\n");                                                                \
+  }
+
+// Work of one thread: operation over its range of the generated keys
+typedef struct worker {
+  ht_conc_table_t *table;
+  int first;
+  int count;
+  int step;
+  int found;
+} worker_t;
+
+void init_test() {
+  printf("Concurrent Hash Table - testing script\n");
+  printf("--------------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void *insert_worker(void *arg) {
+  worker_t *worker = arg;
+  for (int i = worker->first; i < worker->first + worker->count;
+       i += worker->step) {
+    ht_conc_insert(worker->table, generated_keys[i], (float)i);
+  }
+  return NULL;
+}
+
+void *delete_worker(void *arg) {
+  worker_t *worker = arg;
+  for (int i = worker->first; i < worker->first + worker->count;
+       i += worker->step) {
+    ht_conc_delete(worker->table, generated_keys[i]);
+  }
+  return NULL;
+}
+
+void *get_worker(void *arg) {
+  worker_t *worker = arg;
+  float value;
+  worker->found = 0;
+  for (int i = worker->first; i < worker->first + worker->count;
+       i += worker->step) {
+    if (ht_conc_get(worker->table, generated_keys[i], &value) &&
+        value == (float)i) {
+      worker->found++;
+    }
+  }
+  return NULL;
+}
+
+// Runs the routine in THREADS threads, each one over its own range of keys
+void run_workers(ht_conc_table_t *table, void *(*routine)(void *), int step) {
+  pthread_t threads[THREADS];
+  worker_t workers[THREADS];
+  for (int t = 0; t < THREADS; t++) {
+    workers[t] = (worker_t){table, t * KEYS_PER_THREAD, KEYS_PER_THREAD, step,
+                            0};
+    pthread_create(&threads[t], NULL, routine, &workers[t]);
+  }
+  for (int t = 0; t < THREADS; t++) {
+    pthread_join(threads[t], NULL);
+  }
+}
+
+bool conc_get(void *table, char *key, float *value) {
+  return ht_conc_get(table, key, value);
+}
+
+CONC_TEST(test_table_init, "Initialize the table", 6)
+float value = 1.0;
+printf("Found: %s, value: %.2f\n",
+       ht_conc_get(&test_table, "Ethereum", &value) ? "yes" : "no", value);
+END_CONC_TEST
+
+CONC_TEST(test_insert, "Insert and update items", 4)
+float value;
+ht_conc_insert(&test_table, "Bitcoin", 53247.71);
+ht_conc_insert(&test_table, "Ethereum", 3208.67);
+ht_conc_insert(&test_table, "Ethereum", 12.34);
+ht_conc_get(&test_table, "Bitcoin", &value);
+printf("Bitcoin: %.2f\n", value);
+ht_conc_get(&test_table, "Ethereum", &value);
+printf("Ethereum: %.2f\n", value);
+printf("Contains Monero: %s\n",
+       ht_conc_contains(&test_table, "Monero") ? "yes" : "no");
+printf("Hash changed while not empty: %s\n",
+       ht_conc_set_hash(&test_table, ht_hash_fnv1a, 0) ? "yes" : "no");
+END_CONC_TEST
+
+CONC_TEST(test_parallel_insert, "Insert from many threads", 16)
+run_workers(&test_table, insert_worker, 1);
+check_generated(&test_table, conc_get, WORKER_KEYS, 1);
+END_CONC_TEST
+
+CONC_TEST(test_parallel_get, "Get from many threads", 16)
+run_workers(&test_table, insert_worker, 1);
+run_workers(&test_table, get_worker, 1);
+check_generated(&test_table, conc_get, WORKER_KEYS, 1);
+END_CONC_TEST
+
+CONC_TEST(test_parallel_delete, "Delete every second item from many threads",
+          16)
+run_workers(&test_table, insert_worker, 1);
+pthread_t threads[THREADS];
+worker_t workers[THREADS];
+for (int t = 0; t < THREADS; t++) {
+  // Deleting threads run together with the reading ones
+  workers[t] = (worker_t){&test_table, (t / 2) * 2 * KEYS_PER_THREAD + 1,
+                          2 * KEYS_PER_THREAD - 1, 2, 0};
+  if (t % 2 == 1) {
+    workers[t].first--;
+  }
+  pthread_create(&threads[t], NULL, t % 2 == 0 ? delete_worker : get_worker,
+                 &workers[t]);
+}
+for (int t = 0; t < THREADS; t++) {
+  pthread_join(threads[t], NULL);
+}
+check_generated(&test_table, conc_get, WORKER_KEYS, 2);
+END_CONC_TEST
+
+CONC_TEST(test_single_shard, "Insert from many threads into one shard", 1)
+run_workers(&test_table, insert_worker, 4);
+check_generated(&test_table, conc_get, WORKER_KEYS, 4);
+END_CONC_TEST
+
+CONC_TEST(test_delete_all, "Delete all the items", 8)
+run_workers(&test_table, insert_worker, 1);
+ht_conc_delete_all(&test_table);
+check_generated(&test_table, conc_get, WORKER_KEYS, 1);
+END_CONC_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_table_init();
+  test_insert();
+  test_parallel_insert();
+  test_parallel_get();
+  test_parallel_delete();
+  test_single_shard();
+  test_delete_all();
+}
@@ -0,0 +1,121 @@
+#include "cuckoo.h"
+#include "test_util_open.h"
+#include <stdio.h>
+
+void cuckoo_init(void *table) {
+  ht_cuckoo_init(table);
+  ht_cuckoo_set_hash(table, ht_hash_wy, 0);
+}
+
+void cuckoo_insert(void *table, char *key, float value) {
+  ht_cuckoo_insert(table, key, value);
+}
+
+float *cuckoo_get(void *table, char *key) { return ht_cuckoo_get(table, key); }
+
+void cuckoo_delete(void *table, char *key) { ht_cuckoo_delete(table, key); }
+
+void cuckoo_delete_all(void *table) { ht_cuckoo_delete_all(table); }
+
+size_t cuckoo_count(void *table) {
+  return ((ht_cuckoo_table_t *)table)->count;
+}
+
+void cuckoo_print_summary(void *table) {
+  ht_cuckoo_table_t *cuckoo = table;
+  printf("------------------------------------\n");
+  printf("Total items in hash table: %zu\n", cuckoo->count);
+  printf("Buckets: %zu\n", cuckoo->size);
+  printf("Stashed items: %zu\n", cuckoo->stashed);
+  printf("------------------------------------\n");
+}
+
+const ht_open_test_ops_t CUCKOO_OPS = {
+    .name = "Cuckoo",
+    .size = sizeof(ht_cuckoo_table_t),
+    .init = cuckoo_init,
+    .insert = cuckoo_insert,
+    .get = cuckoo_get,
+    .delete = cuckoo_delete,
+    .delete_all = cuckoo_delete_all,
+    .count = cuckoo_count,
+    .print_summary = cuckoo_print_summary};
+
+// Hash function putting all the keys into the same two buckets (the hashes
+// differ only in the bits not used for bucket indexes of small tables)
+uint64_t colliding_hash(const char *key, size_t length, uint64_t seed) {
+  return (ht_hash_wy(key, length, seed) & 0xffff) << 16;
+}
+
+OPEN_TEST(test_stash, "Use the stash for colliding keys", ht_cuckoo_table_t,
+          &CUCKOO_OPS)
+ht_cuckoo_set_hash(test_table, colliding_hash, 0);
+for (int i = 0; i < 2 * HT_CUCKOO_WAYS + 2; i++) {
+  ht_cuckoo_insert(test_table, TEST_DATA[i].key, TEST_DATA[i].value);
+}
+cuckoo_print_summary(test_table);
+int found = 0;
+for (int i = 0; i < 2 * HT_CUCKOO_WAYS + 2; i++) {
+  found += ht_cuckoo_get(test_table, TEST_DATA[i].key) != NULL;
+}
+printf("Found: %d\n", found);
+ht_cuckoo_delete(test_table, "Bitcoin");
+ht_cuckoo_delete(test_table, "Ethereum");
+ht_cuckoo_delete(test_table, "Cardano");
+ht_print_item_value(ht_cuckoo_get(test_table, "Bitcoin"));
+ht_print_item_value(ht_cuckoo_get(test_table, "Tether"));
+END_OPEN_TEST(&CUCKOO_OPS)
+
+OPEN_TEST(test_grow, "Grow the table by many insertions", ht_cuckoo_table_t,
+          &CUCKOO_OPS)
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  ht_cuckoo_insert(test_table, generated_keys[i], (float)i);
+}
+int found = 0;
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  float *value = ht_cuckoo_get(test_table, generated_keys[i]);
+  found += value != NULL && *value == (float)i;
+}
+printf("Found: %d\n", found);
+END_OPEN_TEST(&CUCKOO_OPS)
+
+// More keys with the same hash than both buckets and the stash can hold
+#define ANAGRAM_COUNT (2 * HT_CUCKOO_WAYS + HT_CUCKOO_STASH + 1)
+
+OPEN_TEST(test_same_hash, "Refuse a key when too many keys have its hash",
+          ht_cuckoo_table_t, &CUCKOO_OPS)
+ht_cuckoo_set_hash(test_table, ht_hash_additive, 0);
+// Rotations of the same letters are anagrams, the additive hash collides
+char anagrams[ANAGRAM_COUNT][ANAGRAM_COUNT + 1];
+int inserted = 0;
+for (int i = 0; i < ANAGRAM_COUNT; i++) {
+  for (int j = 0; j < ANAGRAM_COUNT; j++) {
+    anagrams[i][j] = (char)('a' + (i + j) % ANAGRAM_COUNT);
+  }
+  anagrams[i][ANAGRAM_COUNT] = '\0';
+  inserted += ht_cuckoo_insert(test_table, anagrams[i], (float)i);
+}
+printf("Inserted: %d of %d\n", inserted, ANAGRAM_COUNT);
+ht_print_item_value(ht_cuckoo_get(test_table, anagrams[0]));
+ht_print_item_value(ht_cuckoo_get(test_table, anagrams[ANAGRAM_COUNT - 1]));
+ht_cuckoo_delete(test_table, anagrams[0]);
+inserted = ht_cuckoo_insert(test_table, anagrams[ANAGRAM_COUNT - 1], 1.5);
+printf("Inserted after a deletion: %s\n", inserted ? "yes" : "no");
+ht_print_item_value(ht_cuckoo_get(test_table, anagrams[ANAGRAM_COUNT - 1]));
+END_OPEN_TEST(&CUCKOO_OPS)
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test(&CUCKOO_OPS);
+
+  test_table_init(&CUCKOO_OPS);
+  test_insert_many(&CUCKOO_OPS);
+  test_insert_update(&CUCKOO_OPS);
+  test_delete(&CUCKOO_OPS);
+  test_stash();
+  test_random_operations(&CUCKOO_OPS);
+  test_grow();
+  test_same_hash();
+  test_delete_all(&CUCKOO_OPS);
+}
@@ -0,0 +1,338 @@
+#include "dyn_table.h"
+#include "test_util_dyn.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INSERT_TEST_DATA(TABLE)                                                \
+  ht_dyn_insert_many(TABLE, TEST_DATA,                                         \
+                     sizeof(TEST_DATA) / sizeof(TEST_DATA[0]));
+
+// Long keys replaced by test_own_keys_churn
+#define CHURN_KEYS 200
+#define CHURN_ROUNDS 50
+#define CHURN_KEY_LENGTH 600
+
+void init_test() {
+  printf("Dynamic Hash Table - testing script\n");
+  printf("-----------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void insert_generated(ht_dyn_table_t *table, int count) {
+  for (int i = 0; i < count; i++) {
+    ht_dyn_insert(table, generated_keys[i], (float)i);
+  }
+}
+
+bool dyn_get(void *table, char *key, float *value) {
+  float *found = ht_dyn_get(table, key);
+  if (found != NULL) {
+    *value = *found;
+  }
+  return found != NULL;
+}
+
+DYN_TEST(test_table_init, "Initialize the table")
+ht_dyn_search(&test_table, "Ethereum");
+END_DYN_TEST
+
+DYN_TEST(test_insert_many, "Insert many new items")
+INSERT_TEST_DATA(&test_table)
+ht_dyn_print_table(&test_table);
+END_DYN_TEST
+
+DYN_TEST(test_search, "Search for existing and non-existing items")
+INSERT_TEST_DATA(&test_table)
+ht_print_item(ht_dyn_search(&test_table, "Terra"));
+ht_print_item(ht_dyn_search(&test_table, "Monero"));
+END_DYN_TEST
+
+DYN_TEST(test_insert_update, "Update an item")
+INSERT_TEST_DATA(&test_table)
+ht_dyn_insert(&test_table, "Ethereum", 12.34);
+ht_print_item_value(ht_dyn_get(&test_table, "Ethereum"));
+END_DYN_TEST
+
+DYN_TEST(test_delete, "Delete an item")
+INSERT_TEST_DATA(&test_table)
+ht_dyn_delete(&test_table, "Terra");
+ht_dyn_delete(&test_table, "Monero");
+ht_print_item_value(ht_dyn_get(&test_table, "Terra"));
+ht_dyn_print_table(&test_table);
+END_DYN_TEST
+
+DYN_TEST(test_grow_start, "Start growing the table")
+INSERT_TEST_DATA(&test_table)
+ht_dyn_insert(&test_table, "Monero", 222.43);
+ht_dyn_insert(&test_table, "Stellar", 0.35);
+ht_dyn_print_table(&test_table);
+ht_print_item_value(ht_dyn_get(&test_table, "Bitcoin"));
+ht_print_item_value(ht_dyn_get(&test_table, "Stellar"));
+END_DYN_TEST
+
+DYN_TEST(test_grow_many, "Grow the table by many insertions")
+insert_generated(&test_table, GENERATED_COUNT);
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+END_DYN_TEST
+
+DYN_TEST(test_delete_many, "Delete every second item")
+insert_generated(&test_table, GENERATED_COUNT);
+for (int i = 1; i < GENERATED_COUNT; i += 2) {
+  ht_dyn_delete(&test_table, generated_keys[i]);
+}
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 2);
+END_DYN_TEST
+
+DYN_TEST(test_delete_all, "Delete all the items")
+insert_generated(&test_table, GENERATED_COUNT);
+ht_dyn_delete_all(&test_table);
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_slab_insert_many, "Insert many new items (slab)",
+              HT_DYN_SLAB)
+INSERT_TEST_DATA(&test_table)
+ht_dyn_print_table(&test_table);
+printf("Slabs: %zu\n", test_table.pool.slab_count);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_slab_reuse, "Reuse deleted items (slab)", HT_DYN_SLAB)
+insert_generated(&test_table, GENERATED_COUNT);
+printf("Slabs: %zu\n", test_table.pool.slab_count);
+for (int i = 1; i < GENERATED_COUNT; i += 2) {
+  ht_dyn_delete(&test_table, generated_keys[i]);
+}
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 2);
+for (int i = 1; i < GENERATED_COUNT; i += 2) {
+  ht_dyn_insert(&test_table, generated_keys[i], (float)i);
+}
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+printf("Slabs: %zu\n", test_table.pool.slab_count);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_slab_delete_all, "Delete all the items (slab)", HT_DYN_SLAB)
+insert_generated(&test_table, GENERATED_COUNT);
+ht_dyn_delete_all(&test_table);
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+printf("Slabs: %zu\n", test_table.pool.slab_count);
+insert_generated(&test_table, GENERATED_COUNT);
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_own_keys, "Insert copies of keys", HT_DYN_OWN_KEYS)
+char buffer[64];
+strcpy(buffer, "XRP");
+ht_dyn_insert(&test_table, buffer, 0.93);
+strcpy(buffer, "Binance Coin and other long keys");
+ht_dyn_insert(&test_table, buffer, 409.15);
+strcpy(buffer, "overwritten");
+ht_print_item(ht_dyn_search(&test_table, "XRP"));
+ht_print_item(ht_dyn_search(&test_table, "Binance Coin and other long keys"));
+ht_print_item(ht_dyn_search(&test_table, "overwritten"));
+printf("Bytes in arena: %zu\n", test_table.keys.bytes);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_own_keys_slab, "Insert copies of keys (slab)",
+              HT_DYN_OWN_KEYS | HT_DYN_SLAB)
+char buffer[16];
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  strcpy(buffer, generated_keys[i]);
+  ht_dyn_insert(&test_table, buffer, (float)i);
+}
+strcpy(buffer, "");
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+END_DYN_TEST
+
+// Writes the round-th long key of the given length into the buffer
+void make_long_key(char *buffer, int round, int index, int length) {
+  int written = sprintf(buffer, "round-%d-key-%d-", round, index);
+  memset(buffer + written, 'x', (size_t)(length - written));
+  buffer[length] = '\0';
+}
+
+DYN_TEST_WITH(test_own_keys_churn, "Replace long keys many times",
+              HT_DYN_OWN_KEYS)
+char buffer[CHURN_KEY_LENGTH + 1];
+size_t memory = 0;
+for (int round = 0; round < CHURN_ROUNDS; round++) {
+  for (int i = 0; i < CHURN_KEYS; i++) {
+    int length = 16 + (i * 37) % (CHURN_KEY_LENGTH - 16);
+    if (round > 0) {
+      make_long_key(buffer, round - 1, i, length);
+      ht_dyn_delete(&test_table, buffer);
+    }
+    make_long_key(buffer, round, i, length);
+    ht_dyn_insert(&test_table, buffer, (float)i);
+  }
+
+  ht_dyn_stats_t stats;
+  ht_dyn_stats(&test_table, &stats);
+  if (round == 0) {
+    memory = stats.memory;
+  } else if (stats.memory != memory) {
+    printf("Memory changed in round %d\n", round);
+  }
+}
+make_long_key(buffer, CHURN_ROUNDS - 1, 5, 16 + 5 * 37);
+ht_print_item_value(ht_dyn_get(&test_table, buffer));
+make_long_key(buffer, 0, 5, 16 + 5 * 37);
+ht_print_item_value(ht_dyn_get(&test_table, buffer));
+printf("Bytes in arena: %zu\n", test_table.keys.bytes);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_intern, "Intern equal strings", HT_DYN_OWN_KEYS)
+char first[16] = "Ethereum";
+char second[16] = "Ethereum";
+char *canonical = ht_dyn_intern(&test_table, first);
+printf("Same pointer for equal strings: %s\n",
+       canonical == ht_dyn_intern(&test_table, second) ? "yes" : "no");
+printf("Different pointer for other strings: %s\n",
+       canonical != ht_dyn_intern(&test_table, "Bitcoin") ? "yes" : "no");
+strcpy(first, "changed");
+printf("Canonical key: %s\n", canonical);
+
+ht_dyn_table_t prices;
+ht_dyn_init_with(&prices, HT_DYN_INTERNED);
+ht_dyn_insert(&prices, canonical, 3208.67);
+ht_print_item_value(ht_dyn_get(&prices, ht_dyn_intern(&test_table, second)));
+ht_print_item_value(ht_dyn_get(&prices, second));
+ht_dyn_delete_all(&prices);
+END_DYN_TEST
+
+DYN_TEST(test_get_many, "Get values of many items at once")
+insert_generated(&test_table, GENERATED_COUNT);
+for (int i = 1; i < GENERATED_COUNT; i += 3) {
+  ht_dyn_delete(&test_table, generated_keys[i]);
+}
+char *keys[GENERATED_COUNT + 1];
+float *values[GENERATED_COUNT + 1];
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  keys[i] = generated_keys[(i * 7) % GENERATED_COUNT];
+}
+keys[GENERATED_COUNT] = "Monero";
+ht_dyn_get_many(&test_table, keys, GENERATED_COUNT + 1, values);
+int differences = 0;
+int found = 0;
+for (int i = 0; i <= GENERATED_COUNT; i++) {
+  differences += values[i] != ht_dyn_get(&test_table, keys[i]);
+  found += values[i] != NULL;
+}
+printf("Found: %d, differences from ht_dyn_get: %d\n", found, differences);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_stats, "Statistics of the table", HT_DYN_STATS)
+INSERT_TEST_DATA(&test_table)
+ht_dyn_insert(&test_table, "Ethereum", 12.34);
+ht_dyn_delete(&test_table, "Terra");
+ht_dyn_get(&test_table, "Bitcoin");
+ht_dyn_get(&test_table, "Monero");
+ht_dyn_print_stats(&test_table);
+insert_generated(&test_table, GENERATED_COUNT);
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+ht_dyn_print_stats(&test_table);
+ht_dyn_reset_counters(&test_table);
+ht_dyn_delete_all(&test_table);
+ht_dyn_print_stats(&test_table);
+END_DYN_TEST
+
+DYN_TEST(test_insert_bulk, "Insert generated items at once")
+ht_item_t *items = malloc(GENERATED_COUNT * sizeof(ht_item_t));
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  items[i].key = generated_keys[i];
+  items[i].value = (float)i;
+}
+insert_generated(&test_table, 300);
+ht_dyn_delete(&test_table, generated_keys[0]);
+printf("Rehashing before: %s\n", ht_dyn_rehashing(&test_table) ? "yes" : "no");
+ht_dyn_insert_bulk(&test_table, items + 200, GENERATED_COUNT - 200);
+ht_dyn_insert_bulk(&test_table, items, 200);
+printf("Rehashing after: %s\n", ht_dyn_rehashing(&test_table) ? "yes" : "no");
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+ht_dyn_print_stats(&test_table);
+free(items);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_insert_bulk_duplicates, "Insert duplicate keys at once",
+              HT_DYN_OWN_KEYS | HT_DYN_SLAB | HT_DYN_STATS)
+ht_item_t items[] = {{"Bitcoin", 1, NULL, 0}, {"Terra", 2, NULL, 0},
+                     {"Bitcoin", 3, NULL, 0}, {"Solana", 4, NULL, 0},
+                     {"Terra", 5, NULL, 0},   {"Bitcoin", 53247.71, NULL, 0}};
+ht_dyn_insert_bulk(&test_table, items, sizeof(items) / sizeof(items[0]));
+ht_dyn_insert_bulk(&test_table, items, 0);
+ht_dyn_print_table(&test_table);
+ht_dyn_print_stats(&test_table);
+END_DYN_TEST
+
+DYN_TEST_WITH(test_bloom, "Answer misses by the Bloom filter",
+              HT_DYN_BLOOM | HT_DYN_STATS)
+char missing_keys[GENERATED_COUNT][16];
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  sprintf(missing_keys[i], "missing-%d", i);
+}
+insert_generated(&test_table, GENERATED_COUNT);
+check_generated(&test_table, dyn_get, GENERATED_COUNT, 1);
+int found = 0;
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  found += ht_dyn_get(&test_table, missing_keys[i]) != NULL;
+}
+printf("Found missing keys: %d, filtered: %zu\n", found,
+       test_table.counters.filtered);
+printf("Filter capacity: %zu, added: %zu\n", test_table.bloom.capacity,
+       test_table.bloom.added);
+for (int i = 1; i < GENERATED_COUNT; i += 2) {
+  ht_dyn_delete(&test_table, generated_keys[i]);
+}
+printf("Filter capacity: %zu, added: %zu\n", test_table.bloom.capacity,
+       test_table.bloom.added);
+for (int i = 0; i < GENERATED_COUNT; i += 2) {
+  ht_dyn_delete(&test_table, generated_keys[i]);
+}
+insert_generated(&test_table, 100);
+printf("Filter capacity: %zu, added: %zu\n", test_table.bloom.capacity,
+       test_table.bloom.added);
+check_generated(&test_table, dyn_get, 100, 1);
+ht_dyn_reset_counters(&test_table);
+char *keys[200];
+float *values[200];
+for (int i = 0; i < 200; i++) {
+  keys[i] = i % 2 == 0 ? generated_keys[i / 2] : missing_keys[i];
+}
+ht_dyn_get_many(&test_table, keys, 200, values);
+found = 0;
+for (int i = 0; i < 200; i++) {
+  found += values[i] != NULL;
+}
+printf("Found by get_many: %d, filtered: %zu\n", found,
+       test_table.counters.filtered);
+ht_dyn_print_stats(&test_table);
+END_DYN_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_table_init();
+  test_insert_many();
+  test_search();
+  test_insert_update();
+  test_delete();
+  test_grow_start();
+  test_grow_many();
+  test_delete_many();
+  test_delete_all();
+  test_slab_insert_many();
+  test_slab_reuse();
+  test_slab_delete_all();
+  test_own_keys();
+  test_own_keys_slab();
+  test_own_keys_churn();
+  test_intern();
+  test_get_many();
+  test_stats();
+  test_insert_bulk();
+  test_insert_bulk_duplicates();
+  test_bloom();
+}
@@ -0,0 +1,134 @@
+#include "generic.h"
+#include "hashtable.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Instance for a user-defined key type
+typedef struct point {
+  int x;
+  int y;
+} point_t;
+
+#define POINT_HASH(KEY, SEED)                                                  \
+  ht_generic_hash_int((uint64_t)(uint32_t)(KEY).x << 32 | (uint32_t)(KEY).y,   \
+                      SEED)
+#define POINT_EQ(A, B) ((A).x == (B).x && (A).y == (B).y)
+
+HTDEC(point_t, double, point)
+HTDEF(point_t, double, point, POINT_HASH, POINT_EQ)
+
+void init_test() {
+  printf("Generic Hash Tables - testing script\n");
+  printf("------------------------------------\n");
+  printf("\n");
+}
+
+void check_u64(ht_u64_table_t *table, int step) {
+  int found = 0;
+  int missing = 0;
+  int wrong = 0;
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    float *value = ht_u64_get(table, (uint64_t)i * 1000003);
+    if (value == NULL) {
+      missing++;
+    } else if (i % step != 0 || *value != (float)i) {
+      wrong++;
+    } else {
+      found++;
+    }
+  }
+  printf("Found: %d, missing: %d, unexpected: %d\n", found, missing, wrong);
+}
+
+void print_str_item(ht_str_item_t *item) {
+  if (item != NULL) {
+    printf("(%s,%.2f)\n", item->key, item->value);
+  } else {
+    printf("NULL\n");
+  }
+}
+
+void test_u64_insert() {
+  printf("[test_u64_insert] Insert and update integer keys\n");
+  ht_u64_table_t table;
+  ht_u64_init(&table);
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    ht_u64_insert(&table, (uint64_t)i * 1000003, (float)-i);
+  }
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    ht_u64_insert(&table, (uint64_t)i * 1000003, (float)i);
+  }
+  check_u64(&table, 1);
+  printf("Items: %zu, buckets: %zu\n", table.count, table.size);
+  ht_u64_delete_all(&table);
+  printf("\n");
+}
+
+void test_u64_delete() {
+  printf("[test_u64_delete] Delete every second integer key\n");
+  ht_u64_table_t table;
+  ht_u64_init(&table);
+  for (int i = 0; i < GENERATED_COUNT; i++) {
+    ht_u64_insert(&table, (uint64_t)i * 1000003, (float)i);
+  }
+  int deleted = 0;
+  for (int i = 1; i < GENERATED_COUNT; i += 2) {
+    deleted += ht_u64_delete(&table, (uint64_t)i * 1000003);
+  }
+  deleted += ht_u64_delete(&table, 1);
+  printf("Deleted: %d\n", deleted);
+  check_u64(&table, 2);
+  ht_u64_delete_all(&table);
+  check_u64(&table, 1);
+  printf("Items: %zu, buckets: %zu\n", table.count, table.size);
+  printf("\n");
+}
+
+void test_str() {
+  printf("[test_str] Insert and search string keys\n");
+  ht_str_table_t table;
+  ht_str_init(&table);
+  for (size_t i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {
+    ht_str_insert(&table, TEST_DATA[i].key, TEST_DATA[i].value);
+  }
+  char key[16] = "Terra";
+  print_str_item(ht_str_search(&table, key));
+  print_str_item(ht_str_search(&table, "Monero"));
+  ht_str_delete(&table, "Terra");
+  print_str_item(ht_str_search(&table, "Terra"));
+  printf("Items: %zu, buckets: %zu\n", table.count, table.size);
+  ht_str_delete_all(&table);
+  printf("\n");
+}
+
+void test_struct_key() {
+  printf("[test_struct_key] Keys and values of user-defined types\n");
+  ht_point_table_t table;
+  ht_point_init(&table);
+  for (int x = -10; x < 10; x++) {
+    for (int y = -10; y < 10; y++) {
+      ht_point_insert(&table, (point_t){x, y}, x * 100.0 + y);
+    }
+  }
+  double *value = ht_point_get(&table, (point_t){-3, 7});
+  printf("Value of (-3,7): %.1f\n", value != NULL ? *value : 0.0);
+  printf("Contains (7,-3): %s\n",
+         ht_point_search(&table, (point_t){7, -3}) != NULL ? "yes" : "no");
+  printf("Contains (10,0): %s\n",
+         ht_point_search(&table, (point_t){10, 0}) != NULL ? "yes" : "no");
+  printf("Items: %zu, buckets: %zu\n", table.count, table.size);
+  ht_point_delete_all(&table);
+  printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_u64_insert();
+  test_u64_delete();
+  test_str();
+  test_struct_key();
+}
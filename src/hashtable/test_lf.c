@@ -0,0 +1,177 @@
+#include "lf_table.h"
+#include "test_util.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define THREADS 8
+#define ROUNDS 20
+
+#define LF_TEST(NAME, DESCRIPTION, SHARDS)                                     \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_lf_table_t *test_table = malloc(sizeof(ht_lf_table_t));                 \
+    ht_lf_init(test_table, SHARDS);                                            \
+    ht_lf_set_hash(test_table, ht_hash_wy, 0);                                 \
+    ht_lf_reader_t *reader = ht_lf_register(test_table);
+
+#define END_LF_TEST                                                            \
+  ht_lf_unregister(reader);                                                    \
+  size_t waiting = ht_lf_reclaim(test_table);                                  \
+  printf("Items: %zu, waiting for reclamation: %zu\n",                         \
+         ht_lf_count(test_table), waiting);                                    \
+  ht_lf_destroy(test_table);                                                   \
+  free(test_table);                                                            \
+  printf("\n");                                                                \
+  }
+
+// Table and reader used by lf_get
+typedef struct lf_lookup {
+  ht_lf_table_t *table;
+  ht_lf_reader_t *reader;
+} lf_lookup_t;
+
+// Work of one thread
+typedef struct worker {
+  ht_lf_table_t *table;
+  int wrong;
+} worker_t;
+
+void init_test() {
+  printf("Lock-free Reads Hash Table - testing script\n");
+  printf("-------------------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void insert_generated(ht_lf_table_t *table, int count) {
+  for (int i = 0; i < count; i++) {
+    ht_lf_insert(table, generated_keys[i], (float)i);
+  }
+}
+
+bool lf_get(void *lookup, char *key, float *value) {
+  lf_lookup_t *lf = lookup;
+  return ht_lf_get(lf->table, lf->reader, key, value);
+}
+
+// Reads even keys (never deleted) and odd keys (deleted and inserted again)
+void *read_worker(void *arg) {
+  worker_t *worker = arg;
+  ht_lf_reader_t *reader = ht_lf_register(worker->table);
+  float value;
+  worker->wrong = 0;
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < GENERATED_KEYS; i++) {
+      bool found = ht_lf_get(worker->table, reader, generated_keys[i], &value);
+      if ((i % 2 == 0 && !found) || (found && value != (float)i)) {
+        worker->wrong++;
+      }
+    }
+  }
+  ht_lf_unregister(reader);
+  return NULL;
+}
+
+void *write_worker(void *arg) {
+  worker_t *worker = arg;
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 1; i < GENERATED_KEYS; i += 2) {
+      ht_lf_delete(worker->table, generated_keys[i]);
+    }
+    for (int i = 1; i < GENERATED_KEYS; i += 2) {
+      ht_lf_insert(worker->table, generated_keys[i], (float)i);
+    }
+  }
+  return NULL;
+}
+
+LF_TEST(test_table_init, "Initialize the table", 4)
+float value = 1.0;
+printf("Found: %s, value: %.2f\n",
+       ht_lf_get(test_table, reader, "Ethereum", &value) ? "yes" : "no",
+       value);
+END_LF_TEST
+
+LF_TEST(test_insert, "Insert, update and search items", 4)
+ht_lf_insert(test_table, "Bitcoin", 53247.71);
+ht_lf_insert(test_table, "Ethereum", 3208.67);
+ht_lf_insert(test_table, "Ethereum", 12.34);
+ht_lf_read_begin(test_table, reader);
+ht_print_item(ht_lf_search(test_table, "Bitcoin"));
+ht_print_item(ht_lf_search(test_table, "Ethereum"));
+ht_print_item(ht_lf_search(test_table, "Monero"));
+ht_lf_read_end(reader);
+printf("Hash changed while not empty: %s\n",
+       ht_lf_set_hash(test_table, ht_hash_fnv1a, 0) ? "yes" : "no");
+END_LF_TEST
+
+LF_TEST(test_deferred_reclamation, "Delete an item being read", 4)
+ht_lf_insert(test_table, "Terra", 30.67);
+ht_lf_insert(test_table, "Litecoin", 156.87);
+ht_lf_read_begin(test_table, reader);
+ht_item_t *item = ht_lf_search(test_table, "Terra");
+ht_lf_delete(test_table, "Terra");
+ht_lf_delete(test_table, "Monero");
+printf("Waiting while read: %zu\n", ht_lf_reclaim(test_table));
+ht_print_item(item);
+ht_print_item(ht_lf_search(test_table, "Terra"));
+ht_lf_read_end(reader);
+printf("Waiting after read: %zu\n", ht_lf_reclaim(test_table));
+END_LF_TEST
+
+LF_TEST(test_grow, "Grow shards by many insertions", 4)
+insert_generated(test_table, GENERATED_KEYS);
+check_generated(&(lf_lookup_t){test_table, reader}, lf_get,
+                GENERATED_KEYS, 1);
+END_LF_TEST
+
+LF_TEST(test_delete_many, "Delete every second item", 4)
+insert_generated(test_table, GENERATED_KEYS);
+for (int i = 1; i < GENERATED_KEYS; i += 2) {
+  ht_lf_delete(test_table, generated_keys[i]);
+}
+check_generated(&(lf_lookup_t){test_table, reader}, lf_get,
+                GENERATED_KEYS, 2);
+END_LF_TEST
+
+LF_TEST(test_parallel_read, "Read while another thread deletes and inserts",
+        8)
+insert_generated(test_table, GENERATED_KEYS);
+pthread_t threads[THREADS];
+worker_t workers[THREADS];
+for (int t = 0; t < THREADS; t++) {
+  workers[t] = (worker_t){test_table, 0};
+  pthread_create(&threads[t], NULL, t == 0 ? write_worker : read_worker,
+                 &workers[t]);
+}
+int wrong = 0;
+for (int t = 0; t < THREADS; t++) {
+  pthread_join(threads[t], NULL);
+  wrong += workers[t].wrong;
+}
+printf("Wrong reads: %d\n", wrong);
+check_generated(&(lf_lookup_t){test_table, reader}, lf_get,
+                GENERATED_KEYS, 1);
+END_LF_TEST
+
+LF_TEST(test_delete_all, "Delete all the items", 4)
+insert_generated(test_table, GENERATED_KEYS);
+ht_lf_delete_all(test_table);
+check_generated(&(lf_lookup_t){test_table, reader}, lf_get,
+                GENERATED_KEYS, 1);
+END_LF_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_table_init();
+  test_insert();
+  test_deferred_reclamation();
+  test_grow();
+  test_delete_many();
+  test_parallel_read();
+  test_delete_all();
+}
@@ -0,0 +1,104 @@
+#include "hashtable.h"
+#include "mph.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MPH_TEST(NAME, DESCRIPTION)                                            \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_table_t *test_table;                                                    \
+    init_test_table(&test_table);                                              \
+    ht_init(test_table);                                                       \
+    ht_mph_table_t test_mph;
+
+#define END_MPH_TEST                                                           \
+  printf("Items: %u, buckets of displacements: %u\n", test_mph.count,         \
+         test_mph.bucket_count);                                               \
+  ht_mph_destroy(&test_mph);                                                   \
+  ht_delete_all(test_table);                                                   \
+  free(test_table);                                                            \
+  printf("\n");                                                                \
+  }
+
+void init_test() {
+  printf("Minimal Perfect Hash Table - testing script\n");
+  printf("-------------------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void build(ht_mph_table_t *mph, ht_table_t *table) {
+  printf("Built: %s\n", ht_mph_build(mph, table) ? "yes" : "no");
+}
+
+void print_slots(ht_mph_table_t *mph) {
+  for (uint32_t i = 0; i < mph->count; i++) {
+    printf("%u: (%s,%.2f)\n", i, mph->items[i].key, mph->items[i].value);
+  }
+}
+
+MPH_TEST(test_empty, "Build from an empty table")
+build(&test_mph, test_table);
+ht_print_item_value(ht_mph_get(&test_mph, "Bitcoin"));
+END_MPH_TEST
+
+MPH_TEST(test_build, "Build from the test data")
+ht_insert_many(test_table, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]));
+build(&test_mph, test_table);
+print_slots(&test_mph);
+END_MPH_TEST
+
+MPH_TEST(test_search, "Search for existing and non-existing items")
+ht_insert_many(test_table, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]));
+build(&test_mph, test_table);
+ht_mph_item_t *item = ht_mph_search(&test_mph, "Terra");
+printf("(%s,%.2f)\n", item->key, item->value);
+printf("%s\n", ht_mph_search(&test_mph, "Monero") == NULL ? "NULL" : "found");
+ht_print_item_value(ht_mph_get(&test_mph, "XRP"));
+ht_print_item_value(ht_mph_get(&test_mph, "Stellar"));
+END_MPH_TEST
+
+MPH_TEST(test_source_deleted, "Search after the source table is deleted")
+ht_insert_many(test_table, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]));
+build(&test_mph, test_table);
+ht_delete_all(test_table);
+ht_print_item_value(ht_mph_get(&test_mph, "Bitcoin"));
+ht_print_item_value(ht_mph_get(&test_mph, "Chainlink"));
+END_MPH_TEST
+
+MPH_TEST(test_many, "Build from many items")
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  ht_insert(test_table, generated_keys[i], (float)i);
+}
+build(&test_mph, test_table);
+int found = 0;
+int wrong = 0;
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  float *value = ht_mph_get(&test_mph, generated_keys[i]);
+  if (value != NULL && *value == (float)i) {
+    found++;
+  } else {
+    wrong++;
+  }
+}
+int misses = 0;
+char key[16];
+for (int i = GENERATED_COUNT; i < 2 * GENERATED_COUNT; i++) {
+  sprintf(key, "key-%d", i);
+  misses += ht_mph_get(&test_mph, key) == NULL;
+}
+printf("Found: %d, wrong: %d, correct misses: %d\n", found, wrong, misses);
+END_MPH_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_empty();
+  test_build();
+  test_search();
+  test_source_deleted();
+  test_many();
+}
@@ -0,0 +1,184 @@
+#include "ordered.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ORD_TEST(NAME, DESCRIPTION)                                            \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_ord_table_t test_table;                                                 \
+    ht_ord_init(&test_table);                                                  \
+    ht_ord_set_hash(&test_table, ht_hash_wy, 0);
+
+#define END_ORD_TEST                                                           \
+  printf("\n");                                                                \
+  ht_ord_print_summary(&test_table);                                           \
+  ht_ord_delete_all(&test_table);                                              \
+  printf("\n");                                                                \
+  }
+
+void init_test() {
+  printf("Ordered Hash Table - testing script\n");
+  printf("-----------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void ht_ord_print_summary(ht_ord_table_t *table) {
+  printf("------------------------------------\n");
+  printf("Total items in hash table: %zu\n", table->count);
+  printf("Used entries: %zu\n", table->used);
+  printf("Size: %zu\n", table->size);
+  printf("------------------------------------\n");
+}
+
+void ht_ord_print_entry(ht_ord_entry_t *entry) {
+  if (entry != NULL) {
+    printf("(%s,%.2f)\n", entry->key, entry->value);
+  } else {
+    printf("NULL\n");
+  }
+}
+
+void ht_ord_print_items(ht_ord_table_t *table) {
+  ht_ord_cursor_t cursor;
+  ht_ord_cursor_init(table, &cursor);
+  ht_ord_entry_t *entry;
+  while ((entry = ht_ord_next(table, &cursor)) != NULL) {
+    printf("(%s,%.2f)", entry->key, entry->value);
+  }
+  printf("\n");
+}
+
+void insert_test_data(ht_ord_table_t *table) {
+  for (size_t i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {
+    ht_ord_insert(table, TEST_DATA[i].key, TEST_DATA[i].value);
+  }
+}
+
+bool ord_get(void *table, char *key, float *value) {
+  float *found = ht_ord_get(table, key);
+  if (found != NULL) {
+    *value = *found;
+  }
+  return found != NULL;
+}
+
+ORD_TEST(test_table_init, "Initialize the table")
+ht_ord_print_entry(ht_ord_search(&test_table, "Ethereum"));
+ht_ord_delete(&test_table, "Ethereum");
+ht_ord_print_items(&test_table);
+END_ORD_TEST
+
+ORD_TEST(test_insert_many, "Iterate in the order of insertion")
+insert_test_data(&test_table);
+ht_ord_print_items(&test_table);
+ht_ord_print_entry(ht_ord_search(&test_table, "Terra"));
+ht_ord_print_entry(ht_ord_search(&test_table, "Monero"));
+END_ORD_TEST
+
+ORD_TEST(test_insert_update, "Update keeps the position")
+insert_test_data(&test_table);
+ht_ord_insert(&test_table, "Ethereum", 12.34);
+ht_ord_print_items(&test_table);
+END_ORD_TEST
+
+ORD_TEST(test_delete, "Delete and insert again")
+insert_test_data(&test_table);
+ht_ord_delete(&test_table, "Bitcoin");
+ht_ord_delete(&test_table, "Terra");
+ht_ord_delete(&test_table, "Monero");
+ht_ord_insert(&test_table, "Bitcoin", 60000);
+ht_ord_print_items(&test_table);
+ht_ord_print_entry(ht_ord_search(&test_table, "Terra"));
+END_ORD_TEST
+
+ORD_TEST(test_delete_current, "Delete items during the iteration")
+insert_test_data(&test_table);
+ht_ord_cursor_t cursor;
+ht_ord_cursor_init(&test_table, &cursor);
+ht_ord_entry_t *entry;
+while ((entry = ht_ord_next(&test_table, &cursor)) != NULL) {
+  if (entry->value < 1) {
+    // Current item
+    ht_ord_delete(&test_table, entry->key);
+  } else if (entry->value > 10000) {
+    // Item which hasn't been visited yet
+    ht_ord_delete(&test_table, "Terra");
+  } else {
+    printf("(%s,%.2f)", entry->key, entry->value);
+  }
+}
+printf("\n");
+ht_ord_print_items(&test_table);
+END_ORD_TEST
+
+ORD_TEST(test_compact, "Compact the deleted entries")
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  ht_ord_insert(&test_table, generated_keys[i], (float)i);
+  if (i % 4 != 0) {
+    ht_ord_delete(&test_table, generated_keys[i]);
+  }
+}
+check_generated(&test_table, ord_get, GENERATED_COUNT, 4);
+ht_ord_cursor_t cursor;
+ht_ord_cursor_init(&test_table, &cursor);
+int visited = 0;
+int ordered = 1;
+float previous = -1;
+ht_ord_entry_t *entry;
+while ((entry = ht_ord_next(&test_table, &cursor)) != NULL) {
+  ordered &= entry->value > previous;
+  previous = entry->value;
+  visited++;
+}
+printf("Visited: %d, in order: %s\n", visited, ordered ? "yes" : "no");
+ht_ord_compact(&test_table);
+ht_ord_print_summary(&test_table);
+check_generated(&test_table, ord_get, GENERATED_COUNT, 4);
+ht_ord_delete(&test_table, generated_keys[0]);
+ht_ord_insert(&test_table, generated_keys[0], 0);
+ht_ord_print_entry(&test_table.entries[test_table.used - 1]);
+END_ORD_TEST
+
+ORD_TEST(test_compact_iteration, "Compact the deleted entries by an iteration")
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  ht_ord_insert(&test_table, generated_keys[i], (float)i);
+}
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  if (i % 10 != 0) {
+    ht_ord_delete(&test_table, generated_keys[i]);
+  }
+}
+ht_ord_print_summary(&test_table);
+ht_ord_cursor_t cursor;
+ht_ord_cursor_init(&test_table, &cursor);
+int visited = 0;
+while (ht_ord_next(&test_table, &cursor) != NULL) {
+  visited++;
+}
+printf("Visited: %d\n", visited);
+END_ORD_TEST
+
+ORD_TEST(test_delete_all, "Delete all the items")
+insert_test_data(&test_table);
+ht_ord_delete_all(&test_table);
+ht_ord_print_items(&test_table);
+insert_test_data(&test_table);
+ht_ord_print_entry(ht_ord_search(&test_table, "Chainlink"));
+END_ORD_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_table_init();
+  test_insert_many();
+  test_insert_update();
+  test_delete();
+  test_delete_current();
+  test_compact();
+  test_compact_iteration();
+  test_delete_all();
+}
@@ -0,0 +1,125 @@
+#include "snapshot.h"
+#include "test_util_dyn.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define SNAPSHOT_PATH "test-snapshot.tmp"
+
+#define SNAP_TEST(NAME, DESCRIPTION)                                           \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_dyn_table_t source;                                                     \
+    ht_dyn_init(&source);                                                      \
+    ht_dyn_set_hash(&source, ht_hash_wy, 0);                                   \
+    ht_snap_t test_snap;
+
+#define END_SNAP_TEST                                                          \
+  printf("Items: %zu, copied: %s\n", ht_snap_count(&test_snap),                \
+         test_snap.copied ? "yes" : "no");                                     \
+  ht_snap_close(&test_snap);                                                   \
+  ht_dyn_delete_all(&source);                                                  \
+  remove(SNAPSHOT_PATH);                                                       \
+  printf("\n");                                                                \
+  }
+
+void init_test() {
+  printf("Hash Table Snapshots - testing script\n");
+  printf("-------------------------------------\n");
+  generate_keys();
+  printf("\n");
+}
+
+void print_value(const float *value) {
+  if (value != NULL) {
+    printf("%.2f\n", *value);
+  } else {
+    printf("NULL\n");
+  }
+}
+
+bool snap_get(void *snap, char *key, float *value) {
+  const float *found = ht_snap_get(snap, key);
+  if (found != NULL) {
+    *value = *found;
+  }
+  return found != NULL;
+}
+
+void write_and_open(ht_dyn_table_t *source, ht_snap_t *snap) {
+  printf("Written: %s\n", ht_snap_write(source, SNAPSHOT_PATH) ? "yes" : "no");
+  printf("Opened: %s\n", ht_snap_open(snap, SNAPSHOT_PATH) ? "yes" : "no");
+}
+
+SNAP_TEST(test_empty, "Snapshot of an empty table")
+write_and_open(&source, &test_snap);
+print_value(ht_snap_get(&test_snap, "Bitcoin"));
+printf("Buckets: %llu\n", (unsigned long long)test_snap.header->size);
+END_SNAP_TEST
+
+SNAP_TEST(test_get, "Get values from the mapped file")
+ht_dyn_insert_many(&source, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]));
+write_and_open(&source, &test_snap);
+print_value(ht_snap_get(&test_snap, "Terra"));
+print_value(ht_snap_get(&test_snap, "Chainlink"));
+print_value(ht_snap_get(&test_snap, "Monero"));
+printf("Buckets: %llu\n", (unsigned long long)test_snap.header->size);
+END_SNAP_TEST
+
+SNAP_TEST(test_generated, "Get values of many items")
+for (int i = 0; i < 600; i++) {
+  ht_dyn_insert(&source, generated_keys[i], (float)i);
+}
+printf("Rehashing while written: %s\n",
+       ht_dyn_rehashing(&source) ? "yes" : "no");
+write_and_open(&source, &test_snap);
+check_generated(&test_snap, snap_get, 600, 1);
+END_SNAP_TEST
+
+SNAP_TEST(test_copy_on_write, "Modify the snapshot")
+for (int i = 0; i < GENERATED_COUNT; i++) {
+  ht_dyn_insert(&source, generated_keys[i], (float)i);
+}
+write_and_open(&source, &test_snap);
+for (int i = 1; i < GENERATED_COUNT; i += 2) {
+  ht_snap_delete(&test_snap, generated_keys[i]);
+}
+ht_snap_insert(&test_snap, "Monero", 222.43);
+check_generated(&test_snap, snap_get, GENERATED_COUNT, 2);
+print_value(ht_snap_get(&test_snap, "Monero"));
+
+ht_snap_t reopened;
+ht_snap_open(&reopened, SNAPSHOT_PATH);
+printf("File unchanged: ");
+check_generated(&reopened, snap_get, GENERATED_COUNT, 1);
+ht_snap_close(&reopened);
+END_SNAP_TEST
+
+SNAP_TEST(test_invalid, "Open invalid files")
+printf("Missing file opened: %s\n",
+       ht_snap_open(&test_snap, "missing.tmp") ? "yes" : "no");
+FILE *file = fopen(SNAPSHOT_PATH, "w");
+fprintf(file, "This is not a snapshot of the hash table, just a text file.\n");
+fprintf(file, "It is long enough to contain the whole header of a snapshot.\n");
+fclose(file);
+printf("Text file opened: %s\n",
+       ht_snap_open(&test_snap, SNAPSHOT_PATH) ? "yes" : "no");
+ht_snap_write(&source, SNAPSHOT_PATH);
+truncate(SNAPSHOT_PATH, sizeof(ht_snap_header_t) + 4);
+printf("Truncated file opened: %s\n",
+       ht_snap_open(&test_snap, SNAPSHOT_PATH) ? "yes" : "no");
+ht_snap_write(&source, SNAPSHOT_PATH);
+ht_snap_open(&test_snap, SNAPSHOT_PATH);
+END_SNAP_TEST
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test();
+
+  test_empty();
+  test_get();
+  test_generated();
+  test_copy_on_write();
+  test_invalid();
+}
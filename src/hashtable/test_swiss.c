@@ -0,0 +1,55 @@
+#include "swiss.h"
+#include "test_util_open.h"
+#include <stdio.h>
+
+void swiss_init(void *table) {
+  ht_swiss_init(table);
+  ht_swiss_set_hash(table, ht_hash_wy, 0);
+}
+
+void swiss_insert(void *table, char *key, float value) {
+  ht_swiss_insert(table, key, value);
+}
+
+float *swiss_get(void *table, char *key) { return ht_swiss_get(table, key); }
+
+void swiss_delete(void *table, char *key) { ht_swiss_delete(table, key); }
+
+void swiss_delete_all(void *table) { ht_swiss_delete_all(table); }
+
+size_t swiss_count(void *table) {
+  return ((ht_swiss_table_t *)table)->count;
+}
+
+void swiss_print_summary(void *table) {
+  ht_swiss_table_t *swiss = table;
+  printf("------------------------------------\n");
+  printf("Total items in hash table: %zu\n", swiss->count);
+  printf("Capacity: %zu\n", swiss->capacity);
+  printf("Tombstones: %zu\n", swiss->tombstones);
+  printf("------------------------------------\n");
+}
+
+const ht_open_test_ops_t SWISS_OPS = {
+    .name = "Swiss",
+    .size = sizeof(ht_swiss_table_t),
+    .init = swiss_init,
+    .insert = swiss_insert,
+    .get = swiss_get,
+    .delete = swiss_delete,
+    .delete_all = swiss_delete_all,
+    .count = swiss_count,
+    .print_summary = swiss_print_summary};
+
+int main(int argc, char *argv[]) {
+  (void)argc;
+  (void)argv;
+  init_test(&SWISS_OPS);
+
+  test_table_init(&SWISS_OPS);
+  test_insert_many(&SWISS_OPS);
+  test_insert_update(&SWISS_OPS);
+  test_delete(&SWISS_OPS);
+  test_random_operations(&SWISS_OPS);
+  test_delete_all(&SWISS_OPS);
+}
@@ -5,6 +5,18 @@
 
 ht_item_t *uninitialized_item;
 
+const ht_item_t TEST_DATA[TEST_DATA_COUNT] = {
+    {"Bitcoin", 53247.71, NULL, 0},    {"Ethereum", 3208.67, NULL, 0},
+    {"Binance Coin", 409.15, NULL, 0}, {"Cardano", 1.82, NULL, 0},
+    {"Tether", 0.86, NULL, 0},         {"XRP", 0.93, NULL, 0},
+    {"Solana", 134.50, NULL, 0},       {"Polkadot", 34.99, NULL, 0},
+    {"Dogecoin", 0.22, NULL, 0},       {"USD Coin", 0.86, NULL, 0},
+    {"Uniswap", 21.68, NULL, 0},       {"Terra", 30.67, NULL, 0},
+    {"Litecoin", 156.87, NULL, 0},     {"Avalanche", 47.03, NULL, 0},
+    {"Chainlink", 21.90, NULL, 0}};
+
+char generated_keys[GENERATED_KEYS][16];
+
 void ht_print_item_value(float *value) {
   if (value != NULL) {
     printf("%.2f\n", *value);
@@ -55,6 +67,31 @@ void init_uninitialized_item() {
   uninitialized_item->key = "*UNINITIALIZED*";
   uninitialized_item->value = -1;
   uninitialized_item->next = NULL;
+  uninitialized_item->hash = 0;
+}
+
+void generate_keys() {
+  for (int i = 0; i < GENERATED_KEYS; i++) {
+    sprintf(generated_keys[i], "key-%d", i);
+  }
+}
+
+// Only the keys whose index is a multiple of step are expected in the table
+void check_generated(void *table, ht_test_get_t get, int count, int step) {
+  int found = 0;
+  int missing = 0;
+  int wrong = 0;
+  float value;
+  for (int i = 0; i < count; i++) {
+    if (!get(table, generated_keys[i], &value)) {
+      missing++;
+    } else if (i % step != 0 || value != (float)i) {
+      wrong++;
+    } else {
+      found++;
+    }
+  }
+  printf("Found: %d, missing: %d, unexpected: %d\n", found, missing, wrong);
 }
 
 void init_test_table(ht_table_t **table) {
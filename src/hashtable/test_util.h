@@ -17,7 +17,21 @@
   printf("\n");                                                                \
   }
 
+// Items inserted by the tests of all the tables
+#define TEST_DATA_COUNT 15
+
+// Number of the keys "key-0", "key-1", ... filled by generate_keys
+#define GENERATED_KEYS 16000
+
+// Number of the generated keys inserted by the tests of the tables
+#define GENERATED_COUNT 1000
+
+// Looks up the value of a key in the tested table, false if it's missing
+typedef bool (*ht_test_get_t)(void *table, char *key, float *value);
+
 extern ht_item_t *uninitialized_item;
+extern const ht_item_t TEST_DATA[TEST_DATA_COUNT];
+extern char generated_keys[GENERATED_KEYS][16];
 
 void ht_print_item_value(float *value);
 void ht_print_item(ht_item_t *item);
@@ -25,6 +39,8 @@ void ht_print_table(ht_table_t *table);
 void ht_insert_many(ht_table_t *table, const ht_item_t items[], int count);
 
 void init_uninitialized_item();
+void generate_keys();
+void check_generated(void *table, ht_test_get_t get, int count, int step);
 void init_test_table(ht_table_t **table);
 
 #endif
@@ -0,0 +1,60 @@
+#include "test_util_dyn.h"
+#include <stdio.h>
+
+void ht_dyn_print_buckets(ht_item_t **buckets, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    printf("%zu: ", i);
+    ht_item_t *item = buckets[i];
+    while (item != NULL) {
+      printf("(%s,%.2f)", item->key, item->value);
+      item = item->next;
+    }
+    printf("\n");
+  }
+}
+
+void ht_dyn_print_table(ht_dyn_table_t *table) {
+  printf("---------DYNAMIC HASH TABLE---------\n");
+  if (table->old_buckets != NULL) {
+    printf("Old buckets (migrated up to %zu):\n", table->rehash_index);
+    ht_dyn_print_buckets(table->old_buckets, table->old_size);
+    printf("New buckets:\n");
+  }
+  ht_dyn_print_buckets(table->buckets, table->size);
+  printf("------------------------------------\n");
+}
+
+void ht_dyn_print_summary(ht_dyn_table_t *table) {
+  printf("------------------------------------\n");
+  printf("Total items in hash table: %zu\n", table->count);
+  printf("Number of buckets: %zu\n", table->size);
+  printf("Load factor: %.2f\n", ht_dyn_load_factor(table));
+  printf("Rehashing: %s\n", ht_dyn_rehashing(table) ? "yes" : "no");
+  printf("------------------------------------\n");
+}
+
+void ht_dyn_print_stats(ht_dyn_table_t *table) {
+  ht_dyn_stats_t stats;
+  ht_dyn_stats(table, &stats);
+  printf("------------------------------------\n");
+  printf("Items: %zu, buckets: %zu, load factor: %.2f\n", stats.count,
+         stats.buckets, stats.load_factor);
+  printf("Chain lengths:");
+  for (int i = 0; i <= HT_DYN_HISTOGRAM; i++) {
+    printf(" %d%s:%zu", i, i == HT_DYN_HISTOGRAM ? "+" : "", stats.chains[i]);
+  }
+  printf("\nLongest chain: %zu\n", stats.longest_chain);
+  printf("Hits: %zu, misses: %zu, average probes: %.2f\n",
+         stats.counters.hits, stats.counters.misses, stats.average_probes);
+  printf("Inserts: %zu, updates: %zu, deletes: %zu, grows: %zu\n",
+         stats.counters.inserts, stats.counters.updates,
+         stats.counters.deletes, stats.counters.grows);
+  printf("Allocations: %zu, frees: %zu\n", stats.counters.allocations,
+         stats.counters.frees);
+  printf("------------------------------------\n");
+}
+
+void ht_dyn_insert_many(ht_dyn_table_t *table, const ht_item_t items[],
+                        int count) {
+  ht_dyn_insert_bulk(table, items, (size_t)count);
+}
@@ -0,0 +1,29 @@
+#ifndef IAL_HASHTABLE_TEST_UTIL_DYN_H
+#define IAL_HASHTABLE_TEST_UTIL_DYN_H
+
+#include "dyn_table.h"
+#include "test_util.h"
+
+#define DYN_TEST(NAME, DESCRIPTION) DYN_TEST_WITH(NAME, DESCRIPTION, 0)
+
+#define DYN_TEST_WITH(NAME, DESCRIPTION, FLAGS)                                \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    ht_dyn_table_t test_table;                                                 \
+    ht_dyn_init_with(&test_table, FLAGS);                                      \
+    ht_dyn_set_hash(&test_table, ht_hash_wy, 0);
+
+#define END_DYN_TEST                                                           \
+  printf("\n");                                                                \
+  ht_dyn_print_summary(&test_table);                                           \
+  ht_dyn_delete_all(&test_table);                                              \
+  printf("\n");                                                                \
+  }
+
+void ht_dyn_print_table(ht_dyn_table_t *table);
+void ht_dyn_print_summary(ht_dyn_table_t *table);
+void ht_dyn_print_stats(ht_dyn_table_t *table);
+void ht_dyn_insert_many(ht_dyn_table_t *table, const ht_item_t items[],
+                        int count);
+
+#endif
@@ -0,0 +1,126 @@
+#include "test_util_open.h"
+#include "dyn_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+void *open_test_begin(const ht_open_test_ops_t *ops, const char *name,
+                      const char *description) {
+  printf("[%s] %s\n", name, description);
+  void *table = malloc(ops->size);
+  if (table == NULL) {
+    exit(1);
+  }
+  ops->init(table);
+  return table;
+}
+
+void open_test_end(const ht_open_test_ops_t *ops, void *table) {
+  printf("\n");
+  ops->print_summary(table);
+  ops->delete_all(table);
+  free(table);
+  printf("\n");
+}
+
+void init_test(const ht_open_test_ops_t *ops) {
+  int length = printf("%s Hash Table - testing script", ops->name);
+  printf("\n");
+  for (int i = 0; i < length; i++) {
+    printf("-");
+  }
+  printf("\n");
+  generate_keys();
+  printf("\n");
+}
+
+void open_print_item(const ht_open_test_ops_t *ops, void *table, char *key) {
+  float *value = ops->get(table, key);
+  if (value != NULL) {
+    printf("(%s,%.2f)\n", key, *value);
+  } else {
+    printf("NULL\n");
+  }
+}
+
+void open_insert_test_data(const ht_open_test_ops_t *ops, void *table) {
+  for (int i = 0; i < TEST_DATA_COUNT; i++) {
+    ops->insert(table, TEST_DATA[i].key, TEST_DATA[i].value);
+  }
+}
+
+void test_table_init(const ht_open_test_ops_t *ops) {
+  void *table = open_test_begin(ops, __func__, "Initialize the table");
+  open_print_item(ops, table, "Ethereum");
+  ops->delete(table, "Ethereum");
+  open_test_end(ops, table);
+}
+
+void test_insert_many(const ht_open_test_ops_t *ops) {
+  void *table = open_test_begin(ops, __func__, "Insert many new items");
+  open_insert_test_data(ops, table);
+  open_print_item(ops, table, "Terra");
+  open_print_item(ops, table, "Monero");
+  open_test_end(ops, table);
+}
+
+void test_insert_update(const ht_open_test_ops_t *ops) {
+  void *table = open_test_begin(ops, __func__, "Update an item");
+  open_insert_test_data(ops, table);
+  ops->insert(table, "Ethereum", 12.34);
+  ht_print_item_value(ops->get(table, "Ethereum"));
+  open_test_end(ops, table);
+}
+
+void test_delete(const ht_open_test_ops_t *ops) {
+  void *table = open_test_begin(ops, __func__, "Delete an item");
+  open_insert_test_data(ops, table);
+  ops->delete(table, "Terra");
+  ops->delete(table, "Monero");
+  ht_print_item_value(ops->get(table, "Terra"));
+  ht_print_item_value(ops->get(table, "Bitcoin"));
+  open_test_end(ops, table);
+}
+
+void test_random_operations(const ht_open_test_ops_t *ops) {
+  void *table = open_test_begin(ops, __func__,
+                                "Compare random operations with ht_dyn");
+  ht_dyn_table_t reference;
+  ht_dyn_init(&reference);
+  unsigned state = 1;
+  int differences = 0;
+  for (int i = 0; i < 200000; i++) {
+    state = state * 1103515245 + 12345;
+    char *key = generated_keys[(state >> 8) % GENERATED_COUNT];
+    switch ((state >> 24) % 4) {
+    case 0:
+    case 1:
+      ops->insert(table, key, (float)i);
+      ht_dyn_insert(&reference, key, (float)i);
+      break;
+    case 2:
+      ops->delete(table, key);
+      ht_dyn_delete(&reference, key);
+      break;
+    default: {
+      float *value = ops->get(table, key);
+      float *expected = ht_dyn_get(&reference, key);
+      if ((value == NULL) != (expected == NULL) ||
+          (value != NULL && *value != *expected)) {
+        differences++;
+      }
+    }
+    }
+  }
+  printf("Differences: %d, items: %zu (expected %zu)\n", differences,
+         ops->count(table), reference.count);
+  ht_dyn_delete_all(&reference);
+  open_test_end(ops, table);
+}
+
+void test_delete_all(const ht_open_test_ops_t *ops) {
+  void *table = open_test_begin(ops, __func__, "Delete all the items");
+  open_insert_test_data(ops, table);
+  ops->delete_all(table);
+  ht_print_item_value(ops->get(table, "Bitcoin"));
+  open_test_end(ops, table);
+}
@@ -0,0 +1,40 @@
+#ifndef IAL_HASHTABLE_TEST_UTIL_OPEN_H
+#define IAL_HASHTABLE_TEST_UTIL_OPEN_H
+
+#include "test_util.h"
+#include <stddef.h>
+
+// Operations of a table tested by the shared tests (swiss and cuckoo tables)
+typedef struct ht_open_test_ops {
+  const char *name;                                    // printed by init_test
+  size_t size;                                         // size of the table
+  void (*init)(void *table);                           // also sets ht_hash_wy
+  void (*insert)(void *table, char *key, float value); // ht_*_insert
+  float *(*get)(void *table, char *key);               // ht_*_get
+  void (*delete)(void *table, char *key);              // ht_*_delete
+  void (*delete_all)(void *table);                     // ht_*_delete_all
+  size_t (*count)(void *table);                        // number of items
+  void (*print_summary)(void *table);                  // printed after tests
+} ht_open_test_ops_t;
+
+#define OPEN_TEST(NAME, DESCRIPTION, TYPE, OPS)                                \
+  void NAME() {                                                                \
+    TYPE *test_table = open_test_begin(OPS, #NAME, DESCRIPTION);
+
+#define END_OPEN_TEST(OPS)                                                     \
+  open_test_end(OPS, test_table);                                              \
+  }
+
+void *open_test_begin(const ht_open_test_ops_t *ops, const char *name,
+                      const char *description);
+void open_test_end(const ht_open_test_ops_t *ops, void *table);
+
+void init_test(const ht_open_test_ops_t *ops);
+void test_table_init(const ht_open_test_ops_t *ops);
+void test_insert_many(const ht_open_test_ops_t *ops);
+void test_insert_update(const ht_open_test_ops_t *ops);
+void test_delete(const ht_open_test_ops_t *ops);
+void test_random_operations(const ht_open_test_ops_t *ops);
+void test_delete_all(const ht_open_test_ops_t *ops);
+
+#endif